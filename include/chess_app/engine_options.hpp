@@ -0,0 +1,66 @@
+#ifndef CHESSAPP_ENGINE_OPTIONS_HPP
+#define CHESSAPP_ENGINE_OPTIONS_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace ChessApp
+{
+    /*************************************************************************************************
+     * @struct EngineOptions
+     * @brief The UCI options the engine is configured with when it starts.
+     *
+     * The defaults are sized from the machine by FromHardware, and a config file read by FromFile
+     * can override any of them. UCIHandler only sends the options the engine says it supports.
+     ************************************************************************************************/
+    struct EngineOptions
+    {
+        /** @brief The number of search threads ("Threads"). */
+        int threads = 1;
+
+        /** @brief The size of the transposition table in MB ("Hash"). */
+        int hash_mb = 16;
+
+        /** @brief The number of best lines the engine searches for ("MultiPV"). */
+        int multi_pv = 1;
+
+        /** @brief How search threads are bound to NUMA nodes ("NumaPolicy"), not sent if empty. */
+        std::string numa_policy;
+
+        /** @brief Let the engine think on the expected reply during the opponent's turn ("Ponder"). */
+        bool ponder = true;
+
+        /***************************************************************************************
+         * @brief Size the options from the cores and memory this process may use.
+         *
+         * Container limits (CPU affinity, cgroup CPU quota and memory limit) count, not just the
+         * host. One core is left for the GUI, and the hash table gets a sixteenth of the memory,
+         * rounded down to a power of two and kept between 16 MB and 16 GB.
+         *
+         * @return The options sized for this machine.
+         **************************************************************************************/
+        static EngineOptions FromHardware();
+
+        /***************************************************************************************
+         * @brief Read the options from a config file on top of the hardware sizing.
+         *
+         * One "Name = value" per line with Threads, Hash, MultiPV, NumaPolicy or Ponder (true or
+         * false) as the name, in any case. Blank lines and lines starting with '#' are skipped.
+         * An option the file does not set keeps its hardware sizing, as do all of them if the
+         * file does not exist.
+         *
+         * @param path The path to the config file.
+         * @return The options.
+         * @throws std::invalid_argument If a line is malformed or a value is out of range.
+         **************************************************************************************/
+        static EngineOptions FromFile(const std::string &path);
+
+        /** @brief Get the number of logical cores this process may run on, at least 1. */
+        static unsigned int GetUsableCoreCount();
+
+        /** @brief Get the bytes of memory this process may use, 0 if unknown. */
+        static std::uint64_t GetUsableMemoryBytes();
+    };
+} // namespace ChessApp
+
+#endif
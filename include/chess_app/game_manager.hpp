@@ -10,11 +10,14 @@
 #include "game_render/renderer/board_renderer.hpp"
 #include "game_render/renderer/highlight_renderer.hpp"
 
+#include "chess_app/search_limits.hpp"
 #include "chess_app/uci_handler.hpp"
 
 #include <SFML/Window.hpp>
 #include <SFML/Graphics.hpp>
 
+#include <future>
+#include <string>
 #include <vector>
 #include <optional>
 #include <algorithm>
@@ -65,6 +68,12 @@ namespace ChessApp
 
             ChessApp::UCIHandler uci_handler_;
 
+            // When the engine's searches stop
+            ChessApp::SearchLimits ai_search_limits_;
+
+            // The best move of the engine's running search, polled every frame
+            std::future<ChessApp::BestMove> ai_move_future_;
+
             std::optional<GameLogic::Position> selected_position_;
             std::map<GameLogic::Position, sf::Color> current_legal_positions_with_colors_;
             std::vector<GameLogic::Move> current_legal_moves_;
@@ -108,10 +117,14 @@ namespace ChessApp
 
             void HandlePieceSelection(GameLogic::Position clicked_position);
 
-            void ExecuteAIMove();
+            void ExecuteAIMove(const std::string &uci_best_move);
 
             void TryExecuteAIMove();
 
+            void CancelAIMove();
+
+            bool IsAITurn() const;
+
             void UpdateHighlight(GameLogic::Position selected_position, sf::Color highlight_color);
 
             void ClearSelectionState();
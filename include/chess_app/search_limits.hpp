@@ -0,0 +1,70 @@
+#ifndef CHESSAPP_SEARCH_LIMITS_HPP
+#define CHESSAPP_SEARCH_LIMITS_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace ChessApp
+{
+    /*************************************************************************************************
+     * @struct SearchLimits
+     * @brief The limits of one engine search, sent as the parameters of the UCI "go" command.
+     *
+     * Every limit is optional and the engine stops at whichever set limit it reaches first. With
+     * no limit set, or with infinite set, the engine searches until it is told to stop.
+     ************************************************************************************************/
+    struct SearchLimits
+    {
+        /** @brief Search this many plies deep ("go depth"). */
+        std::optional<int> depth;
+
+        /** @brief Search exactly this many milliseconds ("go movetime"). */
+        std::optional<int> movetime_ms;
+
+        /** @brief White's remaining clock time in milliseconds ("go wtime"). */
+        std::optional<int> wtime_ms;
+
+        /** @brief Black's remaining clock time in milliseconds ("go btime"). */
+        std::optional<int> btime_ms;
+
+        /** @brief White's increment per move in milliseconds ("go winc"). */
+        std::optional<int> winc_ms;
+
+        /** @brief Black's increment per move in milliseconds ("go binc"). */
+        std::optional<int> binc_ms;
+
+        /** @brief Moves left until the next time control, sudden death if unset ("go movestogo"). */
+        std::optional<int> moves_to_go;
+
+        /** @brief Search this many nodes ("go nodes"). */
+        std::optional<std::uint64_t> nodes;
+
+        /** @brief Search until told to stop, whatever the other limits ("go infinite"). */
+        bool infinite = false;
+
+        /** @brief Limits of a search that stops at a depth. */
+        static SearchLimits Depth(int depth);
+
+        /** @brief Limits of a search that takes a fixed time in milliseconds. */
+        static SearchLimits MoveTime(int movetime_ms);
+
+        /** @brief Limits of a search that manages its own time from both players' clocks, in milliseconds. */
+        static SearchLimits Clock(int wtime_ms, int btime_ms, int winc_ms = 0, int binc_ms = 0);
+
+        /** @brief Limits of a search that stops after a number of nodes. */
+        static SearchLimits Nodes(std::uint64_t nodes);
+
+        /** @brief Limits of a search that only ends on UCIHandler::Stop. */
+        static SearchLimits Infinite();
+
+        /***************************************************************************************
+         * @brief Write the limits as a UCI command.
+         * @return The "go" command with a parameter for every set limit, e.g. "go movetime 500".
+         * @throws std::invalid_argument If a limit is negative or a depth is not positive.
+         **************************************************************************************/
+        std::string ToGoCommand() const;
+    };
+} // namespace ChessApp
+
+#endif
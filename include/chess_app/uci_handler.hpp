@@ -6,17 +6,46 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/process/pipe.hpp>
 
+#include "game_logic/game.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/position_state.hpp"
+
+#include "chess_app/engine_options.hpp"
+#include "chess_app/search_limits.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace ChessApp
 {
     namespace bp = boost::process;
 
+    /** @brief The answer to a search, from the engine's "bestmove" line. */
+    struct BestMove
+    {
+        /** @brief The best move in UCI notation, e.g. "e2e4". */
+        std::string move;
+
+        /** @brief The reply the engine expects to the best move, empty if it gave none. */
+        std::string ponder_move;
+    };
+
     /************************************************************************
      * @class UCIHandler
      * @brief Orchestrates the communication with a chess engine (Stockfish)
      *
      * This class manages the interaction between our Chess GUI and the UCI.
+     * The engine's output is read on a dedicated I/O thread, so a search
+     * runs in the background and its best move arrives through a future.
+     * While the opponent thinks, the engine can ponder on the reply it
+     * expects, see StartPonder.
      ***********************************************************************/
     class UCIHandler
     {
@@ -25,8 +54,9 @@ namespace ChessApp
             /*******************************************************************************************************************
              * @brief Construct a UCIHandler object that will help with the communication between Chess GUI and the Chess Engine
              * @param engine_path The path the the executable for the chess engine
+             * @param options The options the engine is configured with, those it doesn't support are skipped.
              *******************************************************************************************************************/
-            UCIHandler(const std::string &engine_path);
+            UCIHandler(const std::string &engine_path, const EngineOptions &options = EngineOptions::FromHardware());
 
             /** @brief Destructor for UCIHandler, wait for the child process to be over and close all pipes. */
             ~UCIHandler();
@@ -34,10 +64,80 @@ namespace ChessApp
             /****************************************************************************************************************************************************************
              * @brief Get the best move that can be made for this board state.
              * @param fen The string representation of the board state, current player, castling rights, enpassant target and move counters in Forsyth–Edwards Notation (FEN)
-             * @param depth The depth the engines goes to search for moves.
-             * @param search_time_ms The time the engine will take to search for moves in milliseconds.
+             * @param limits When the engine stops searching for moves, an infinite search must be ended with Stop from another thread.
              ***************************************************************************************************************************************************************/
-            std::string GetBestMove(const std::string fen, int depth = 8, int search_time_ms = 2000);
+            std::string GetBestMove(const std::string fen, const SearchLimits &limits = SearchLimits::Depth(8));
+
+            /****************************************************************************************************
+             * @brief Start searching for the best move of a board state without waiting for the engine.
+             * @param fen The board state in Forsyth–Edwards Notation (FEN).
+             * @param limits When the engine stops searching for moves: depth, time, clocks, nodes or infinite.
+             * @return A future that becomes ready with the best move once the engine answers, or holds
+             *         std::runtime_error if the engine exits or its answer can't be parsed.
+             * @throws std::logic_error If a search is already running, a ponder search is stopped first.
+             * @throws std::runtime_error If the engine is not running.
+             * @throws std::invalid_argument If a limit is out of range.
+             ***************************************************************************************************/
+            std::future<BestMove> StartSearch(const std::string &fen, const SearchLimits &limits = SearchLimits::Depth(8));
+
+            /****************************************************************************************************
+             * @brief Start searching for the best move of a game's current position.
+             *
+             * The position is sent as "position startpos moves ..." (or "position fen <start> moves ..." for a
+             * game set up from a FEN), so the engine knows the game's history for repetitions. While the game
+             * only gains moves, the command of the previous search is extended with the new moves instead of
+             * being rebuilt.
+             *
+             * If the engine is pondering and the game's last move is the one it pondered on, the ponder search
+             * carries on as this search ("ponderhit") and its future is returned, often ready at once. Any
+             * other move stops the ponder search and a new search is started.
+             *
+             * @param game The game, which may have changed in any way since the previous search.
+             * @param limits When the engine stops searching for moves, not used on a ponder hit.
+             * @return A future that becomes ready with the best move, as StartSearch above.
+             ***************************************************************************************************/
+            std::future<BestMove> StartSearch(const GameLogic::Game &game, const SearchLimits &limits = SearchLimits::Depth(8));
+
+            /****************************************************************************************************
+             * @brief Let the engine think on the expected reply while the opponent thinks ("go ponder").
+             *
+             * The game continued by the ponder move is searched until StartSearch reports the real move, or
+             * CancelPonder, Stop or NewGame end it. Nothing is started if pondering is disabled in the options
+             * or not supported by the engine.
+             *
+             * @param game The game after the engine's move.
+             * @param ponder_move The reply the engine expects, the ponder_move of its BestMove.
+             * @param limits The limits of the search the ponder search turns into on a ponder hit.
+             * @return true if the engine started pondering.
+             * @throws std::logic_error If a search is already running.
+             ***************************************************************************************************/
+            bool StartPonder(const GameLogic::Game &game, const std::string &ponder_move, const SearchLimits &limits = SearchLimits::Depth(8));
+
+            /** @brief Stop the ponder search, if any, and wait for the engine to drop it. */
+            void CancelPonder();
+
+            /** @brief Check whether the engine is pondering. */
+            bool IsPondering() const;
+
+            /*******************************************************************************
+             * @brief Tell the engine the next search is from a different game.
+             * @throws std::logic_error If a search is running, a ponder search is stopped first.
+             ******************************************************************************/
+            void NewGame();
+
+            /********************************************************************************
+             * @brief Tell the engine to stop the running search, if any.
+             *
+             * The engine answers a stop with the best move found so far, which resolves the
+             * future returned by StartSearch shortly after.
+             *******************************************************************************/
+            void Stop();
+
+            /** @brief Check whether a search was started and has not been answered yet. */
+            bool IsSearching() const;
+
+            /** @brief Get the options the engine was configured with. */
+            const EngineOptions &GetOptions() const;
 
         private:
             /** @brief The child process that will run the stockfish engine program. */
@@ -49,6 +149,47 @@ namespace ChessApp
             /** @brief Parent reads from this stream, child writes to stdout (child's output → parent's input) */
             bp::ipstream pipe_is_;
 
+            /** @brief The options the engine was configured with. */
+            EngineOptions options_;
+
+            /** @brief The names of the options the engine listed in answer to "uci", in lower case. */
+            std::set<std::string> supported_options_;
+
+            /** @brief The start position of the game in position_command_, unset if there is none. */
+            std::optional<GameLogic::PositionState> position_start_;
+
+            /** @brief The moves written in position_command_, compared with the game to find the new ones. */
+            std::vector<GameLogic::Move> position_moves_;
+
+            /** @brief The "position" command of the last game search. */
+            std::string position_command_;
+
+            /** @brief true if the options enable pondering and the engine supports it. */
+            bool is_ponder_enabled_ = false;
+
+            /** @brief The move the running ponder search expects, empty when not pondering. */
+            std::string ponder_move_;
+
+            /** @brief The best move of the running ponder search, handed out on a ponder hit. */
+            std::future<BestMove> ponder_future_;
+
+            /** @brief Guards the members below, shared with the I/O thread. */
+            mutable std::mutex mutex_;
+
+            /** @brief Notified when a response line is queued or the engine's output ends. */
+            std::condition_variable response_cv_;
+
+            /** @brief Response lines not yet consumed by WaitForResponse, search output excluded. */
+            std::deque<std::string> responses_;
+
+            /** @brief The promise of the running search, fulfilled by the I/O thread when "bestmove" arrives. */
+            std::optional<std::promise<BestMove>> search_promise_;
+
+            /** @brief true while the I/O thread is reading the engine's output. */
+            bool is_connected_ = false;
+
+            /** @brief Reads the engine's output line by line until the engine exits. */
+            std::thread io_thread_;
 
             /**************************************************************************************
              * @brief Create the child process and start the interactoin with the stockfish engine.
@@ -56,6 +197,41 @@ namespace ChessApp
              *************************************************************************************/
             void CreateAndConnectUCIProcess(const std::string& engine_path);
 
+            /************************************************************************************************
+             * @brief Bring position_command_ up to date with a game, appending its new moves if it can.
+             * @param game The game to search.
+             ***********************************************************************************************/
+            void UpdatePositionCommand(const GameLogic::Game &game);
+
+            /*****************************************************************************************
+             * @brief Check if a game only added moves to the game of position_command_.
+             * @param game The game.
+             * @return true if the game has the same start position and position_moves_ as its first moves.
+             ****************************************************************************************/
+            bool FollowsPositionCommand(const GameLogic::Game &game) const;
+
+            /**********************************************************************************
+             * @brief Register a search and send its position and go commands to the engine.
+             * @param position_cmd The "position" command.
+             * @param limits The limits of the search.
+             * @param is_ponder true to send "go ponder".
+             * @return The future of the best move.
+             *********************************************************************************/
+            std::future<BestMove> SendSearch(const std::string &position_cmd, const SearchLimits &limits, bool is_ponder = false);
+
+            /***********************************************************************************
+             * @brief Send the configured options to the engine, skipping those it doesn't list.
+             **********************************************************************************/
+            void ApplyOptions();
+
+            /*****************************************************************************************
+             * @brief Set one engine option, if the engine listed it in answer to "uci".
+             * @param name The option name, e.g. "Threads".
+             * @param value The option value.
+             * @return true if the engine has the option.
+             ****************************************************************************************/
+            bool SetOption(const std::string &name, const std::string &value);
+
             /******************************************************************************************************************
              * @brief Send a command to the stockfish engine.
              * @param command A const reference to a string that represent the command we want the stockfish engine to execute.
@@ -64,6 +240,8 @@ namespace ChessApp
 
             /******************************************************************************
              * @brief Tell the stockfish engine to use the UCI (universal chess interface).
+             *
+             * Records the options the engine lists before "uciok".
              * @return true if the command was successful, false otherwise.
              *****************************************************************************/
             bool UseUCI();
@@ -77,8 +255,15 @@ namespace ChessApp
             /* @brief Helper to quit the stockfish engine program. */
             void Quit();
 
+            /**********************************************************************************
+             * @brief The body of the I/O thread: resolve searches and queue the other lines.
+             *
+             * Runs until the engine closes its output, then fails the running search if any.
+             *********************************************************************************/
+            void ReadEngineOutput();
+
             /**********************************************************************************************
-             * @brief Wait for a response after sending the command to the stockfish engine.
+             * @brief Wait for the I/O thread to receive a response after sending a command to the stockfish engine.
              * @param expected_resposnse_substring The subtring that needs to be contained in the response.
              * @return A string that represent the line that contains the subtring.
              *********************************************************************************************/
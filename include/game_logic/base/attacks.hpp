@@ -0,0 +1,83 @@
+#ifndef GAMELOGIC_ATTACKS_HPP
+#define GAMELOGIC_ATTACKS_HPP
+
+#include "game_logic/base/bitboard.hpp"
+
+#include "game_logic/enums.hpp"
+
+namespace GameLogic
+{
+    /*****************************************************************************************************
+     * @brief Precomputed attack tables for every piece type.
+     *
+     * Knight, King and Pawn attacks only depend on the square, so they are plain 64 entry tables.
+     * Bishop and Rook attacks also depend on which squares are occupied along their rays. They are
+     * looked up with magic bitboards: the relevant occupancy is multiplied by a per square magic number
+     * and shifted down into an index of a shared attack table. When the compiler targets BMI2 the index
+     * is computed with the PEXT instruction instead.
+     *
+     * The tables are built the first time any of these functions is called.
+     ****************************************************************************************************/
+    namespace Attacks
+    {
+        /*********************************************************************
+         * @brief Returns the squares a pawn of the given color attacks.
+         * @param color The color of the pawn (Light attacks North).
+         * @param square The square (0-63) the pawn is on.
+         * @return A Bitboard of the (at most two) diagonal capture squares.
+         ********************************************************************/
+        Bitboard PawnAttacks(Enums::Color color, int square);
+
+        /** @brief Returns the squares a knight on the given square attacks. */
+        Bitboard KnightAttacks(int square);
+
+        /** @brief Returns the squares a king on the given square attacks (castling excluded). */
+        Bitboard KingAttacks(int square);
+
+        /************************************************************************************
+         * @brief Returns the squares a bishop on the given square attacks.
+         * @param square The square (0-63) the bishop is on.
+         * @param occupied Every occupied square on the board. Rays stop at the first one.
+         * @return A Bitboard of attacked squares, including the first blocker on each ray.
+         ***********************************************************************************/
+        Bitboard BishopAttacks(int square, Bitboard occupied);
+
+        /************************************************************************************
+         * @brief Returns the squares a rook on the given square attacks.
+         * @param square The square (0-63) the rook is on.
+         * @param occupied Every occupied square on the board. Rays stop at the first one.
+         * @return A Bitboard of attacked squares, including the first blocker on each ray.
+         ***********************************************************************************/
+        Bitboard RookAttacks(int square, Bitboard occupied);
+
+        /** @brief Returns the squares a queen on the given square attacks (bishop | rook). */
+        Bitboard QueenAttacks(int square, Bitboard occupied);
+
+        /*******************************************************************************
+         * @brief Returns the attacks of a non pawn piece type from the given square.
+         * @param piece_type The type of the piece (Knight, Bishop, Rook, Queen, King).
+         * @param square The square (0-63) the piece is on.
+         * @param occupied Every occupied square on the board (used by sliders only).
+         * @return A Bitboard of attacked squares.
+         ******************************************************************************/
+        Bitboard PieceAttacks(Enums::PieceType piece_type, int square, Bitboard occupied);
+
+        /*****************************************************************************************
+         * @brief Returns the squares strictly between two squares on the same rank, file or diagonal.
+         * @param from_square One end of the segment.
+         * @param to_square The other end of the segment.
+         * @return The squares in between, or an empty Bitboard if the squares are not aligned.
+         ****************************************************************************************/
+        Bitboard Between(int from_square, int to_square);
+
+        /*****************************************************************************************
+         * @brief Returns the full rank, file or diagonal running through two aligned squares.
+         * @param from_square The first square.
+         * @param to_square The second square.
+         * @return The whole line (edge to edge), or an empty Bitboard if the squares are not aligned.
+         ****************************************************************************************/
+        Bitboard Line(int from_square, int to_square);
+    } // namespace Attacks
+} // namespace GameLogic
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef GAMELOGIC_BITBOARD_HPP
+#define GAMELOGIC_BITBOARD_HPP
+
+#include "game_logic/base/position.hpp"
+
+#include "game_logic/enums.hpp"
+#include "game_logic/constants.hpp"
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace GameLogic
+{
+    /*****************************************************************************************
+     * @brief A set of squares packed into a 64 bit integer, one bit per square.
+     *
+     * Squares are indexed the same way as Position: square = row * 8 + col, so a8 is bit 0
+     * and h1 is bit 63. Moving one row North (toward rank 8) is a shift of -8.
+     ****************************************************************************************/
+    using Bitboard = std::uint64_t;
+
+    namespace Bitboards
+    {
+        /** @brief The number of squares on a standard board. */
+        inline constexpr int SQUARE_COUNT = Constants::BOARD_SIZE * Constants::BOARD_SIZE;
+
+        /** @brief The number of distinct (color, piece type) combinations. */
+        inline constexpr int PIECE_COUNT = 12;
+
+        /** @brief The piece index of an empty square, one past the last (color, piece type) pair. */
+        inline constexpr int NO_PIECE = PIECE_COUNT;
+
+        /** @brief Marks the absence of a square (e.g. no en passant target). */
+        inline constexpr int NO_SQUARE = -1;
+
+        /** @brief An empty set of squares. */
+        inline constexpr Bitboard EMPTY = 0ULL;
+
+        /** @brief Every square on the board. */
+        inline constexpr Bitboard ALL = ~0ULL;
+
+        /** @brief The squares on the a file (col 0) and the h file (col 7). */
+        inline constexpr Bitboard FILE_A = 0x0101010101010101ULL;
+        inline constexpr Bitboard FILE_H = FILE_A << 7;
+
+        /** @brief The squares on rank 8 (row 0) and rank 1 (row 7). */
+        inline constexpr Bitboard RANK_8 = 0xFFULL;
+        inline constexpr Bitboard RANK_1 = RANK_8 << 56;
+
+        /** @brief The light squares (a8, c8, ..., h1), the squares where row + col is even. */
+        inline constexpr Bitboard LIGHT_SQUARES = 0xAA55AA55AA55AA55ULL;
+
+        /***********************************************************
+         * @brief Converts a row and col into a square index (0-63).
+         * @param row The 0 based row (0 = rank 8).
+         * @param col The 0 based col (0 = file a).
+         * @return The square index.
+         **********************************************************/
+        inline constexpr int ToSquare(int row, int col)
+        {
+            return row * Constants::BOARD_SIZE + col;
+        }
+
+        /** @brief Converts a Position into a square index (0-63). */
+        inline int ToSquare(const Position &position)
+        {
+            return ToSquare(position.GetRow(), position.GetCol());
+        }
+
+        /** @brief Converts a square index (0-63) back into a Position. */
+        inline Position ToPosition(int square)
+        {
+            return Position{square / Constants::BOARD_SIZE, square % Constants::BOARD_SIZE};
+        }
+
+        /** @brief Returns a Bitboard with only the given square set. */
+        inline constexpr Bitboard SquareBB(int square)
+        {
+            return 1ULL << square;
+        }
+
+        /** @brief Returns true if the given square is set in the Bitboard. */
+        inline constexpr bool Contains(Bitboard bitboard, int square)
+        {
+            return (bitboard >> square) & 1ULL;
+        }
+
+        /** @brief Returns the number of squares set in the Bitboard. */
+        inline int PopCount(Bitboard bitboard)
+        {
+#if defined(_MSC_VER)
+            return static_cast<int>(__popcnt64(bitboard));
+#else
+            return __builtin_popcountll(bitboard);
+#endif
+        }
+
+        /** @brief Returns the lowest set square. The Bitboard must not be empty. */
+        inline int LowestSquare(Bitboard bitboard)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, bitboard);
+            return static_cast<int>(index);
+#else
+            return __builtin_ctzll(bitboard);
+#endif
+        }
+
+        /** @brief Removes and returns the lowest set square. The Bitboard must not be empty. */
+        inline int PopLowestSquare(Bitboard &bitboard)
+        {
+            int square = LowestSquare(bitboard);
+            bitboard &= bitboard - 1;
+            return square;
+        }
+
+        /** @brief Maps a color onto a 0 based index (Light = 0, Dark = 1). */
+        inline constexpr int ColorIndex(Enums::Color color)
+        {
+            return color == Enums::Color::Light ? 0 : 1;
+        }
+
+        /** @brief Maps a piece type onto a 0 based index (Pawn = 0 ... King = 5). */
+        inline constexpr int TypeIndex(Enums::PieceType piece_type)
+        {
+            return static_cast<int>(piece_type) - static_cast<int>(Enums::PieceType::Pawn);
+        }
+
+        /** @brief Maps a (color, piece type) pair onto a 0 based index (0-11). */
+        inline constexpr int PieceIndex(Enums::Color color, Enums::PieceType piece_type)
+        {
+            return ColorIndex(color) * 6 + TypeIndex(piece_type);
+        }
+
+        /**************************************************************************************************
+         * @brief Returns the material signature of a number of pieces of one (color, piece type).
+         *
+         * A material signature packs the piece count of every (color, piece type) into 4 bits at
+         * PieceIndex * 4, so the signature of a whole position is the sum of the signatures of its
+         * pieces and a material balance (e.g. King + Bishop vs King) is a single compare.
+         *
+         * @param color The color of the pieces.
+         * @param piece_type The type of the pieces.
+         * @param count The number of pieces (0-15).
+         * @return The material signature of those pieces.
+         *************************************************************************************************/
+        inline constexpr std::uint64_t MaterialSignature(Enums::Color color, Enums::PieceType piece_type, int count = 1)
+        {
+            return static_cast<std::uint64_t>(count) << (PieceIndex(color, piece_type) * 4);
+        }
+
+        /** @brief Maps a piece index (0-11) back onto the color of the piece. */
+        inline constexpr Enums::Color PieceIndexColor(int piece_index)
+        {
+            return piece_index < 6 ? Enums::Color::Light : Enums::Color::Dark;
+        }
+
+        /** @brief Maps a piece index (0-11) back onto the type of the piece. */
+        inline constexpr Enums::PieceType PieceIndexType(int piece_index)
+        {
+            return static_cast<Enums::PieceType>(piece_index % 6 + static_cast<int>(Enums::PieceType::Pawn));
+        }
+        /**************************************************************************************************
+         * @brief Returns the castling rights that survive a move from or to a square.
+         *
+         * A King or Rook leaving its start square, or a Rook being captured on it, loses the matching
+         * rights, so the rights after a move are the rights before it masked with this for both squares.
+         *
+         * @param square The from or to square (0-63) of a move.
+         * @return A combination of the Constants::CASTLE_* bits that are kept.
+         *************************************************************************************************/
+        inline constexpr int CastlingRightsKeptAfter(int square)
+        {
+            switch (square)
+            {
+                case ToSquare(0, 0):
+                    return Constants::CASTLE_ALL & ~Constants::CASTLE_DARK_QS;
+                case ToSquare(0, 4):
+                    return Constants::CASTLE_ALL & ~(Constants::CASTLE_DARK_KS | Constants::CASTLE_DARK_QS);
+                case ToSquare(0, 7):
+                    return Constants::CASTLE_ALL & ~Constants::CASTLE_DARK_KS;
+                case ToSquare(7, 0):
+                    return Constants::CASTLE_ALL & ~Constants::CASTLE_LIGHT_QS;
+                case ToSquare(7, 4):
+                    return Constants::CASTLE_ALL & ~(Constants::CASTLE_LIGHT_KS | Constants::CASTLE_LIGHT_QS);
+                case ToSquare(7, 7):
+                    return Constants::CASTLE_ALL & ~Constants::CASTLE_LIGHT_KS;
+                default:
+                    return Constants::CASTLE_ALL;
+            }
+        }
+    } // namespace Bitboards
+} // namespace GameLogic
+
+#endif
@@ -5,7 +5,14 @@
 #include "game_logic/base/move.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/move_record.hpp"
+#include "game_logic/base/position_state.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/zobrist.hpp"
 
+#include "game_logic/enums.hpp"
+
+#include <array>
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <memory>
@@ -18,6 +25,14 @@ namespace GameLogic
      * @brief Represents a standard 8x8 chess board and manages the state of the game Pieces.
      *
      * This class handles board initialization, Piece placement, movement logic, and move history.
+     *
+     * Internally the Board keeps one Bitboard per (color, piece type) plus the occupancy of each
+     * color, so that set based queries (where are the Light knights, is this square occupied)
+     * are a single load. The Piece objects are kept in a flat 64 square array alongside the
+     * Bitboards so that GetPieceAt and friends keep working for existing callers.
+     *
+     * The Board also tracks the side to move, the castling rights and the en passant target, and
+     * keeps a Zobrist key of the whole position up to date as pieces are placed and removed.
      ********************************************************************************************/
     class Board
     {
@@ -31,7 +46,8 @@ namespace GameLogic
             /***********************************************************************************
              * @brief Make a move on the Board.
              * @param move The move that is going to be executed.
-             * @return A move record that stores the move made, Piece moved, and Piece captured.
+             * @return A move record that stores the move made, the moved Piece's has moved flag, and
+             *         the Piece captured.
              **********************************************************************************/
             MoveRecord MakeMove(const Move& move);
 
@@ -39,7 +55,7 @@ namespace GameLogic
              * @brief Unmake or undo a move.
              * @param record A move record that stores the move made, Piece moved, and Piece captured.
              ****************************************************************************************/
-            void UnmakeMove(MoveRecord &record);
+            void UnmakeMove(const MoveRecord &record);
 
             /**********************************************************************************************
              * @brief Removes and returns a Piece on the Board at a specified Position.
@@ -96,16 +112,183 @@ namespace GameLogic
              *************************************************************/
             bool ArePositionsEmpty(const std::vector<Position> &positions) const;
 
+            /*********************************************************************
+             * @brief Returns the squares occupied by a given type of Piece.
+             * @param color The color of the Pieces.
+             * @param piece_type The type of the Pieces (Pawn, Knight, ...).
+             * @return A Bitboard with a bit set for each square holding the Piece.
+             ********************************************************************/
+            Bitboard GetPieceBitboard(Enums::Color color, Enums::PieceType piece_type) const;
+
+            /****************************************************************
+             * @brief Returns the squares occupied by all Pieces of a color.
+             * @param color The color of the Pieces.
+             * @return A Bitboard with a bit set for each occupied square.
+             ***************************************************************/
+            Bitboard GetColorBitboard(Enums::Color color) const;
+
+            /***************************************************************
+             * @brief Returns the squares occupied by any Piece.
+             * @return A Bitboard with a bit set for each occupied square.
+             **************************************************************/
+            Bitboard GetOccupiedBitboard() const;
+
+            /*****************************************************************
+             * @brief Returns the square of a player's King.
+             * @param color The color of the King.
+             * @return The square (0-63), or Bitboards::NO_SQUARE if there is no King.
+             ****************************************************************/
+            int GetKingSquare(Enums::Color color) const;
+
+            /************************************************************
+             * @brief Returns the number of Pieces of a color and type.
+             * @param color The color of the Pieces.
+             * @param piece_type The type of the Pieces.
+             * @return The number of such Pieces on the Board.
+             ***********************************************************/
+            int GetPieceCount(Enums::Color color, Enums::PieceType piece_type) const;
+
+            /***************************************************************************************
+             * @brief Returns the material signature of every Piece on the Board.
+             * @return The sum of Bitboards::MaterialSignature over all Pieces (one count per 4 bits).
+             **************************************************************************************/
+            std::uint64_t GetMaterialSignature() const;
+
+            /** @brief Returns the color of the player whose turn it is. */
+            Enums::Color GetSideToMove() const;
+
+            /*******************************************************************
+             * @brief Returns the castling rights that have not been lost yet.
+             * @return A combination of the Constants::CASTLE_* bits.
+             ******************************************************************/
+            int GetCastlingRights() const;
+
+            /*********************************************************************************
+             * @brief Returns the square a pawn skipped over with a double pawn move last turn.
+             * @return The square (0-63), or Bitboards::NO_SQUARE if the last move was not one.
+             ********************************************************************************/
+            int GetEnPassantSquare() const;
+
+            /*****************************************************************************************
+             * @brief Returns the Zobrist key of the current position, maintained by MakeMove/UnmakeMove.
+             *
+             * The en passant target is only part of the key when a pawn can actually capture on it,
+             * so positions that only differ by an unusable en passant square hash the same.
+             *
+             * @return The 64 bit Zobrist key.
+             ****************************************************************************************/
+            ZobristKey GetZobristKey() const;
+
+            /*****************************************************************************************
+             * @brief Sets the state that is not visible from the pieces and recomputes the Zobrist key.
+             * Must be called after setting up a position with PlacePieceAt / RemovePieceAt. The has
+             * moved flag of every Piece is derived from the castling rights and the pawn start rows.
+             * @param side_to_move The color of the player whose turn it is.
+             * @param castling_rights A combination of the Constants::CASTLE_* bits.
+             * @param en_passant_square The en passant target square, or Bitboards::NO_SQUARE.
+             ****************************************************************************************/
+            void SetPositionState(Enums::Color side_to_move, int castling_rights, int en_passant_square);
+
+            /*****************************************************************************************
+             * @brief Replaces the position on the Board with a PositionState snapshot.
+             *
+             * Pieces are reused from the spare pool, so a worker thread can keep one Board and load
+             * each snapshot it is handed into it without allocating once the Board is warm.
+             *
+             * @param state The position to set up.
+             ****************************************************************************************/
+            void LoadPositionState(const PositionState &state);
+
+            /*****************************************************************************************
+             * @brief Replaces every Piece on the Board with the given pieces.
+             *
+             * Pieces are reused from the spare pool like LoadPositionState. SetPositionState must be
+             * called afterwards.
+             *
+             * @param pieces The piece index (Bitboards::PieceIndex) on each square, or Bitboards::NO_PIECE.
+             ****************************************************************************************/
+            void PlacePieces(const std::array<int, Bitboards::SQUARE_COUNT> &pieces);
+
             /** @brief Display the current state of the board. */
             void DisplayBoard() const;
 
-            /** @brief Reset every pieces' position.*/
+            /** @brief Reset every pieces' position, reusing the Pieces already on the Board.*/
             void ResetBoard();
 
         private:
-            /** @brief The 8x8 internal representation of the chess board
+            /** @brief The 8x8 internal representation of the chess board, indexed by square (row * 8 + col).
              *  Each element is a unique_ptr to a Piece or nullptr. */
-            std::vector<std::vector<std::unique_ptr<Piece>>> board_;
+            std::array<std::unique_ptr<Piece>, Bitboards::SQUARE_COUNT> board_;
+
+            /** @brief One Bitboard per (color, piece type), indexed by Bitboards::PieceIndex. */
+            std::array<Bitboard, Bitboards::PIECE_COUNT> piece_bitboards_;
+
+            /** @brief The occupancy of each color, indexed by Bitboards::ColorIndex. */
+            std::array<Bitboard, 2> color_bitboards_;
+
+            /** @brief The number of Pieces of each (color, piece type), indexed by Bitboards::PieceIndex. */
+            std::array<int, Bitboards::PIECE_COUNT> piece_counts_;
+
+            /** @brief The square of each color's King, indexed by Bitboards::ColorIndex. */
+            std::array<int, 2> king_squares_;
+
+            /** @brief The material signature of all Pieces, see Bitboards::MaterialSignature. */
+            std::uint64_t material_signature_;
+
+            /** @brief The color of the player whose turn it is. */
+            Enums::Color side_to_move_;
+
+            /** @brief The castling rights still available, a combination of the Constants::CASTLE_* bits. */
+            int castling_rights_;
+
+            /** @brief The square skipped by the last double pawn move, or Bitboards::NO_SQUARE. */
+            int en_passant_square_;
+
+            /** @brief The Zobrist key of the current position. */
+            ZobristKey zobrist_key_;
+
+            /** @brief Piece objects taken off the board by captures and promotions, indexed by
+             *  Bitboards::PieceIndex. Make/Unmake reuse them so that a move never allocates. */
+            std::array<std::vector<std::unique_ptr<Piece>>, Bitboards::PIECE_COUNT> spare_pieces_;
+
+            /*********************************************************************************************
+             * @brief Helper function to add or remove a Piece's square in the Bitboards and Zobrist key,
+             * and to update the piece counts, material signature and King squares to match.
+             * @param piece The Piece whose Bitboards are updated (ignored if nullptr).
+             * @param square The square (0-63) the Piece is placed on or removed from.
+             ********************************************************************************************/
+            void ToggleBitboards(const Piece *piece, int square);
+
+            /*****************************************************************************************
+             * @brief Helper function to update the side to move, castling rights, en passant target and
+             * their part of the Zobrist key after the pieces of a move have been placed.
+             * The previous en passant key must already have been taken out of the Zobrist key.
+             * @param move The move that was just made.
+             ****************************************************************************************/
+            void UpdatePositionState(const Move &move);
+
+            /** @brief Keeps a Piece that was taken off the board for reuse (ignored if nullptr). */
+            void StoreSparePiece(std::unique_ptr<Piece> piece);
+
+            /*******************************************************************************************
+             * @brief Takes a spare Piece of the given color and type, creating one only if none is kept.
+             * @param color The color of the Piece.
+             * @param piece_type The type of the Piece.
+             * @return A unique_ptr to the Piece, its has moved flag must be set by the caller.
+             ******************************************************************************************/
+            std::unique_ptr<Piece> TakeSparePiece(Enums::Color color, Enums::PieceType piece_type);
+
+            /** @brief Moves every Piece on the Board to the spare pool. */
+            void StoreAllPieces();
+
+            /** @brief Returns the piece a MoveRecord says was captured, or nullptr if there was none. */
+            std::unique_ptr<Piece> TakeCapturedPiece(const MoveRecord &record);
+
+            /** @brief Returns the en passant part of the Zobrist key (0 if no pawn can capture en passant). */
+            ZobristKey GetEnPassantZobristKey() const;
+
+            /** @brief Computes the Zobrist key of the current position from scratch. */
+            ZobristKey ComputeZobristKey() const;
 
             /** @brief Sets up all the pieces in their starting positions.
              *  Called by the Contructor. */
@@ -139,16 +322,16 @@ namespace GameLogic
             // --- Special Unmake Move Handlers --- //
 
             /** @brief Reverts a standard move. */
-            void UnmakeNormalMove(MoveRecord &record);
+            void UnmakeNormalMove(const MoveRecord &record);
 
             /** @brief Reverts an enpassant move. */
-            void UnmakeEnPassantMove(MoveRecord &record);
+            void UnmakeEnPassantMove(const MoveRecord &record);
 
             /** @brief Reverts a pawn promotino move. */
-            void UnmakePawnPromotionMove(MoveRecord &record);
+            void UnmakePawnPromotionMove(const MoveRecord &record);
 
             /** @brief Reverts a king or queen side castling move. */
-            void UnmakeCastleMove(MoveRecord &record);
+            void UnmakeCastleMove(const MoveRecord &record);
     };
 }
 
@@ -0,0 +1,65 @@
+#ifndef GAMELOGIC_FEN_HPP
+#define GAMELOGIC_FEN_HPP
+
+#include "game_logic/base/board.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace GameLogic
+{
+    namespace Fen
+    {
+        /** @brief The FEN of the standard starting position. */
+        inline constexpr const char *START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+        /** @brief A buffer of this size holds any FEN WriteFen produces, including the terminating null. */
+        inline constexpr std::size_t MAX_FEN_LENGTH = 128;
+
+        /** @brief The two move counters at the end of a FEN (Part 5 and 6). */
+        struct FenClocks
+        {
+            /** @brief Half moves since the last capture or pawn move, for the fifty move rule. */
+            int halfmove_clock;
+
+            /** @brief The full move number, starting at 1 and incremented after Dark moves. */
+            int fullmove_number;
+        };
+
+        /*****************************************************************************************************
+         * @brief Sets up a Board from a FEN string.
+         *
+         * The pieces are placed, the side to move, castling rights and en passant target are set through
+         * Board::SetPositionState, which also derives Piece::HasMoved from the castling rights and pawn rows.
+         * The move counters are optional and default to "0 1".
+         *
+         * Positions the move generator can't play from are rejected: each side needs exactly one King,
+         * at most 8 pawns and 16 pieces, no pawn on the first or last rank, and the side not to move
+         * must not be in check. Castling rights whose King or Rook is not on its starting square, and
+         * an en passant target no pawn push could have left, are dropped.
+         *
+         * @param fen The position in Forsyth-Edwards Notation.
+         * @param board The Board to set up, its Pieces are reused through the Board's spare pool.
+         * @return The move counters of the FEN.
+         * @throws std::invalid_argument If the FEN is malformed or not a playable position.
+         ****************************************************************************************************/
+        FenClocks LoadFen(const std::string &fen, Board &board);
+
+        /******************************************************************************************************
+         * @brief Writes the FEN of a Board into a caller supplied buffer without allocating.
+         *
+         * The side to move, castling rights and en passant target are read from the Board's incremental
+         * state, so the cost is one pass over the 64 squares.
+         *
+         * @param board The Board to describe.
+         * @param clocks The move counters to write at the end of the FEN.
+         * @param buffer The buffer the null terminated FEN is written into.
+         * @param buffer_size The size of the buffer, at least MAX_FEN_LENGTH.
+         * @return The length of the FEN, not counting the terminating null.
+         * @throws std::length_error If the buffer is smaller than MAX_FEN_LENGTH.
+         *****************************************************************************************************/
+        std::size_t WriteFen(const Board &board, const FenClocks &clocks, char *buffer, std::size_t buffer_size);
+    } // namespace Fen
+} // namespace GameLogic
+
+#endif
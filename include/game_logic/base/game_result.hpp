@@ -64,6 +64,12 @@ namespace GameLogic
              *****************************************************************/
             Enums::Color GetWinnerColor() const noexcept;
 
+            /******************************************************************
+             * @brief Get the result as written in PGN.
+             * @return "1-0", "0-1", "1/2-1/2", or "*" if the game is ongoing.
+             *****************************************************************/
+            const char *GetPgnResult() const noexcept;
+
             /** @brief Reset the game result to ongoing state. */
             void Reset();
 
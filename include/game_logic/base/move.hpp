@@ -5,6 +5,8 @@
 
 #include "game_logic/enums.hpp"
 
+#include <cstdint>
+#include <string>
 #include <tuple>
 
 
@@ -16,6 +18,10 @@ namespace GameLogic
      *
      * This class stores the start and end positions, as well as the specific type of move
      * (normal, castle, promotion, etc.) which is crucial for handling complex chess rules.
+     *
+     * Everything is packed into 16 bits: the start square (bits 0-5), the destination square
+     * (bits 6-11) and a flag (bits 12-15) holding the move type, or the promotion piece for a
+     * PawnPromotion. Positions are decoded from the squares when they are asked for.
      *************************************************************************************/
     class Move
     {
@@ -31,6 +37,14 @@ namespace GameLogic
              ********************************************************************************************/
             Move(Enums::MoveType move_type, const Position&  from_position, const Position& to_position);
 
+            /*******************************************************************************************
+             * @brief Construct a Move object with the move type, start square and destination square
+             * @param move_type The type of Move that was made (Normal, DoublePawn, ...)
+             * @param from_square The starting square (0-63) of the piece that will be moved.
+             * @param to_square The destination square (0-63) of the piece after making the Move.
+             ******************************************************************************************/
+            Move(Enums::MoveType move_type, int from_square, int to_square);
+
             /** @brief Default Destructor. */
             ~Move() = default;
 
@@ -50,6 +64,7 @@ namespace GameLogic
 
             /*******************************************************************************************
              * @brief Set the type of piece the pawn will be promoted to when it gets to the final rank.
+             *        Only a PawnPromotion Move stores a promotion piece, other Moves ignore it.
              * @param promotion_piece_type The piece the pawn will be promoted to.
              ******************************************************************************************/
             void SetPromotionPieceType(Enums::PieceType promotion_piece_type);
@@ -58,13 +73,19 @@ namespace GameLogic
              * @brief Get the starting Position
              * @return The Position from which the Piece will be moved from.
              **************************************************************/
-            const Position& GetFromPosition() const;
+            Position GetFromPosition() const;
 
             /**********************************************************************
              * @brief Get the destination Position
              * @return The Position where the Piece will be after the Move is made.
              *********************************************************************/
-            const Position& GetToPosition() const;
+            Position GetToPosition() const;
+
+            /** @brief Get the starting square (0-63). */
+            int GetFromSquare() const;
+
+            /** @brief Get the destination square (0-63). */
+            int GetToSquare() const;
 
             /**************************************************
              * @brief Get the promotion piece type for pawns.
@@ -79,18 +100,15 @@ namespace GameLogic
              **************************************************************************************/
             static std::tuple<Position, Position, Enums::PieceType> FromUCI(const std::string &uci_string);
 
-        private:
-            /** @brief The type of the Move (Normal, DoublePawn, Enpassant, ...) */
-            Enums::MoveType move_type_;
-
-            /** @brief The tarting Position. */
-            Position from_position_;
+            /******************************************************************************************
+             * @brief Writes the move as a standard UCI move string (e.g., "e2e4", "e1g1", "a7a8q").
+             * @return The move in UCI format, a promotion without a promotion piece is to a queen.
+             *****************************************************************************************/
+            std::string ToUCI() const;
 
-            /** @brief The destination Position. */
-            Position to_position_;
-
-            /** @brief The piece that the pawn will be promoted to. */
-            Enums::PieceType promotion_piece_type_;
+        private:
+            /** @brief The start square, destination square and flag packed into 16 bits. */
+            std::uint16_t data_;
     };
 } // namespace GameLogic
 
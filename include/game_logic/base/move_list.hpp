@@ -0,0 +1,98 @@
+#ifndef GAMELOGIC_MOVE_LIST_HPP
+#define GAMELOGIC_MOVE_LIST_HPP
+
+#include "game_logic/base/move.hpp"
+
+#include "game_logic/constants.hpp"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace GameLogic
+{
+    /*****************************************************************************************
+     * @class MoveList
+     * @brief A fixed capacity list of Moves that lives on the stack.
+     *
+     * Move generation appends into a MoveList instead of returning a std::vector, so that
+     * generating the moves of a position never touches the heap. The capacity is enough for
+     * every legal position (at most 218 moves), so PushBack does not check for overflow.
+     ****************************************************************************************/
+    class MoveList
+    {
+        public:
+            /** @brief Constructs an empty MoveList. The Move storage is left uninitialized. */
+            MoveList() = default;
+
+            /** @brief Default Destructor. */
+            ~MoveList() = default;
+
+            /**************************************************************
+             * @brief Appends a Move to the end of the list.
+             * @param move The Move to append. The list must not be full.
+             *************************************************************/
+            void PushBack(const Move &move)
+            {
+                this->moves_[this->size_++] = move;
+            }
+
+            /** @brief Removes every Move from the list. */
+            void Clear()
+            {
+                this->size_ = 0;
+            }
+
+            /** @brief Returns the number of Moves in the list. */
+            std::size_t Size() const
+            {
+                return this->size_;
+            }
+
+            /** @brief Returns true if the list holds no Moves. */
+            bool Empty() const
+            {
+                return this->size_ == 0;
+            }
+
+            /***************************************************************************
+             * @brief Checks if the list holds a Move (compared with Move::operator==).
+             * @param move The Move to look for.
+             * @return true if an equal Move is in the list, false otherwise.
+             **************************************************************************/
+            bool Contains(const Move &move) const
+            {
+                for (const Move &listed_move : *this)
+                {
+                    if (listed_move == move)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /** @brief Copies the Moves into a std::vector, for callers that keep the vector interface. */
+            std::vector<Move> ToVector() const
+            {
+                return std::vector<Move>(begin(), end());
+            }
+
+            Move &operator[](std::size_t index) { return this->moves_[index]; }
+            const Move &operator[](std::size_t index) const { return this->moves_[index]; }
+
+            Move *begin() { return this->moves_.data(); }
+            Move *end() { return this->moves_.data() + this->size_; }
+            const Move *begin() const { return this->moves_.data(); }
+            const Move *end() const { return this->moves_.data() + this->size_; }
+
+        private:
+            /** @brief The storage for the Moves, only the first size_ entries are valid. */
+            std::array<Move, Constants::MAX_MOVES> moves_;
+
+            /** @brief The number of Moves in the list. */
+            std::size_t size_ = 0;
+    };
+} // namespace GameLogic
+
+#endif
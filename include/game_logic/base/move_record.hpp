@@ -2,9 +2,10 @@
 #define GAMELOGIC_MOVE_RECORD_HPP
 
 #include "game_logic/base/move.hpp"
-#include "game_logic/base/piece.hpp"
+#include "game_logic/base/zobrist.hpp"
 
-#include <memory>
+#include <cstdint>
+#include <type_traits>
 
 namespace GameLogic
 {
@@ -13,8 +14,12 @@ namespace GameLogic
      * @brief A data structure that records the full context of a single Move execution.
      *
      * This record is essential for implementing the `UnmakeMove` (undo) functionality in the `Board` class.
-     * It stores: the Move details, a clone of the piece that moved (before it moved),
-     * and a unique pointer to a piece that was captured during the move.
+     * It stores: the Move details, the has moved flag of the piece that moved (before it moved),
+     * the piece index (Bitboards::PieceIndex) of a piece that was captured during the move, and the
+     * castling rights, en passant target, fifty move counter and Zobrist key before the move.
+     *
+     * The record is plain data (16 bytes) so that the undo and redo histories stay small and can be
+     * copied around freely.
      ******************************************************************************************************/
     class MoveRecord
     {
@@ -22,41 +27,23 @@ namespace GameLogic
             /** @brief Default Constructor. */
             MoveRecord() = default;
 
-            /** @brief Default Destructor. */
-            ~MoveRecord() = default;
-
-
-            /** @brief Default Move constructor. */
-            MoveRecord(MoveRecord&& other_move_record) = default;
-
-            /** @brief Default Move Assignment. */
-            MoveRecord& operator=(MoveRecord&& other_move_record) = default;
-
-
-            /** @brief Disable Copy Constructor. */
-            MoveRecord(MoveRecord& other_move_record) = delete;
-
-            /** @brief Disable Copy Assignment. */
-            MoveRecord operator=(MoveRecord &other_move_record) = delete;
-
-
             /******************************************************
              * @brief Read the Move that was made.
              * @return A const reference to the Move that was made.
              *****************************************************/
             const Move &ReadMoveMade() const;
 
-            /**************************************************************
+            /****************************************************************************
              * @brief Read the Piece that was captured.
-             * @return A const pointer to a Piece object that was captured.
-             *************************************************************/
-            const Piece *ReadCapturedPiece() const;
+             * @return The piece index of the captured Piece, or Bitboards::NO_PIECE.
+             ***************************************************************************/
+            int ReadCapturedPiece() const;
 
-            /*************************************************************
-             * @brief Read the Piece that was taking action.
-             * @return A const pointer to a Piece object that took action.
-             ************************************************************/
-            const Piece *ReadMovedPiece() const;
+            /** @brief Read the has moved flag of the Piece that was captured. */
+            bool ReadCapturedPieceHasMoved() const;
+
+            /** @brief Read the has moved flag of the Piece that took action, before it moved. */
+            bool ReadMovedPieceHasMoved() const;
 
             /*********************************************************************
              * @brief Read the fifty move counter before the move was made.
@@ -64,17 +51,23 @@ namespace GameLogic
              ********************************************************************/
             int ReadPrevFiftyMoveCounter() const;
 
-            /***************************************************************************
-             * @brief Take ownership in the Piece that was captured for unmaking a Move.
-             * @return A unique_ptr to the Piece that was captured.
-             **************************************************************************/
-            std::unique_ptr<Piece> TakeCapturedPiece();
+            /************************************************************************
+             * @brief Read the castling rights before the move was made.
+             * @return A combination of the Constants::CASTLE_* bits.
+             ***********************************************************************/
+            int ReadPrevCastlingRights() const;
+
+            /*******************************************************************************
+             * @brief Read the en passant target square before the move was made.
+             * @return The square (0-63) of the target, or Bitboards::NO_SQUARE if none.
+             ******************************************************************************/
+            int ReadPrevEnPassantSquare() const;
 
-            /******************************************************************************
-             * @brief Take ownership in the Piece that was took action for unmaking a Move.
-             * @return A unique_ptr to the clone of the Piece that moved.
-             *****************************************************************************/
-            std::unique_ptr<Piece> TakeMovedPiece();
+            /***********************************************************
+             * @brief Read the Zobrist key before the move was made.
+             * @return The Zobrist key of the position before the move.
+             **********************************************************/
+            ZobristKey ReadPrevZobristKey() const;
 
 
             /**********************************************************
@@ -83,17 +76,18 @@ namespace GameLogic
              *********************************************************/
             void SetMoveMade(const Move &move);
 
-            /********************************************************************
+            /***************************************************************************************
              * @brief Sets the details of the Piece captured in this record.
-             * @param captured_piece A unique_ptr to the Piece that was captured.
-             *******************************************************************/
-            void SetCapturedPiece(std::unique_ptr<Piece> captured_piece);
+             * @param piece_index The piece index of the captured Piece, or Bitboards::NO_PIECE.
+             * @param has_moved The has moved flag of the captured Piece.
+             **************************************************************************************/
+            void SetCapturedPiece(int piece_index, bool has_moved);
 
-            /*****************************************************************************
-             * @brief Sets the details of the Piece that took action in this record.
-             * @param moved_piece A unique_ptr to the clone of the Piece that took action.
-             ****************************************************************************/
-            void SetMovedPiece(std::unique_ptr<Piece> moved_piece);
+            /***********************************************************************
+             * @brief Sets the has moved flag of the Piece that took action.
+             * @param has_moved The flag of the Piece before the move was made.
+             **********************************************************************/
+            void SetMovedPieceHasMoved(bool has_moved);
 
             /*****************************************************************************
              * @brief Sets the value of the 50 move counter before this move was executed.
@@ -101,19 +95,41 @@ namespace GameLogic
              ****************************************************************************/
             void SetPrevFiftyMoveCounter(int counter);
 
+            /****************************************************************************
+             * @brief Sets the Board state that a move overwrites, so it can be restored.
+             * @param castling_rights The castling rights before the move.
+             * @param en_passant_square The en passant target square before the move.
+             * @param zobrist_key The Zobrist key before the move.
+             ***************************************************************************/
+            void SetPrevBoardState(int castling_rights, int en_passant_square, ZobristKey zobrist_key);
+
         private:
+            /** @brief The Zobrist key of the position immediately prior to this move being made. */
+            ZobristKey prev_zobrist_key_;
+
             /** @brief The Move that was made */
             Move move_made_;
 
-            /** @brief A unique_ptr to the Piece that was captured. */
-            std::unique_ptr<Piece> captured_piece_;
+            /** @brief The value of the 50 move counter immediately prior to this move being made. */
+            std::uint16_t prev_fifty_move_counter_;
+
+            /** @brief The piece index of the Piece that was captured, or Bitboards::NO_PIECE. */
+            std::uint8_t captured_piece_;
 
-            /** @brief A unique_ptr to the clone of the Piece that took action. */
-            std::unique_ptr<Piece> moved_piece_;
+            /** @brief The castling rights immediately prior to this move being made. */
+            std::uint8_t prev_castling_rights_;
 
-            /** @brief The value of the 50 move counter immediately prior to this move being made. */
-            int prev_fifty_move_counter_;
+            /** @brief The en passant target square immediately prior to this move being made. */
+            std::int8_t prev_en_passant_square_;
+
+            /** @brief The has moved flag of the Piece that took action, before it moved. */
+            bool moved_piece_has_moved_ : 1;
+
+            /** @brief The has moved flag of the Piece that was captured. */
+            bool captured_piece_has_moved_ : 1;
     };
+
+    static_assert(std::is_trivially_copyable_v<MoveRecord>, "MoveRecord must stay plain data");
 } // namespace GameLogic
 
-#endif
\ No newline at end of file
+#endif
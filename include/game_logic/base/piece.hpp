@@ -2,6 +2,7 @@
 #define GAMELOGIC_PIECE_HPP
 
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/direction.hpp"
 
@@ -45,7 +46,7 @@ namespace GameLogic
             virtual std::unique_ptr<Piece> ClonePiece() const = 0;
 
             /**************************************************************************************************************************
-             * @brief Calculates all potential moves the Piece can make according to its movement rules.
+             * @brief Appends all potential moves the Piece can make according to its movement rules to a MoveList.
              *
              * This is a pure virtual function must be implemented by derived classes.
              * !!! IMPORTANT: This method calculates *potential* moves based on piece mechanics only.
@@ -53,11 +54,25 @@ namespace GameLogic
              *
              * @param from_position The current position of the Piece on the board.
              * @param board The current state of the Board that is used for validation.
+             * @param moves The MoveList the potential moves are appended to.
+             * @param last_move Optional pointer to the last move made in the game (Needed for En Passant logic).
+             **************************************************************************************************************************/
+            virtual void GeneratePotentialMoves(
+                const Position& from_position, const Board &board, MoveList &moves, const Move* last_move = nullptr) const = 0;
+
+            /**************************************************************************************************************************
+             * @brief Calculates all potential moves the Piece can make according to its movement rules.
+             *
+             * Wraps GeneratePotentialMoves for callers that want a vector.
+             * !!! IMPORTANT: This method does not check for King safety
+             *
+             * @param from_position The current position of the Piece on the board.
+             * @param board The current state of the Board that is used for validation.
              * @param last_move Optional pointer to the last move made in the game (Needed for En Passant logic).
              * @return A vector of potential Move objects.
              **************************************************************************************************************************/
-            virtual std::vector<Move> GetPotentialMoves(
-                const Position& from_position, const Board &board, const Move* last_move = nullptr) const = 0;
+            std::vector<Move> GetPotentialMoves(
+                const Position& from_position, const Board &board, const Move* last_move = nullptr) const;
 
             /**************************************************************************************************
              * @brief Helper function to calculate the position a Piece can move to in EXACTLY ONE Drirection.
@@ -0,0 +1,144 @@
+#ifndef GAMELOGIC_POSITION_STATE_HPP
+#define GAMELOGIC_POSITION_STATE_HPP
+
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/zobrist.hpp"
+
+#include "game_logic/enums.hpp"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace GameLogic
+{
+    class Board;
+
+    /***************************************************************************************************
+     * @class PositionState
+     * @brief A plain data snapshot of a chess position that can be copied between threads.
+     *
+     * Board owns its Pieces through unique_ptr and cannot be copied, so work that needs a position
+     * on another thread takes a PositionState instead: the piece Bitboards, a square to piece index
+     * table, the side to move, castling rights, en passant target, both move counters and the
+     * Zobrist key, in under 200 bytes.
+     *
+     * Moves are applied with value semantics: MakeMove returns the position after the move and
+     * leaves this one untouched, so unmaking a move is simply going back to the earlier copy.
+     * Board::LoadPositionState turns a snapshot back into a Board for move generation.
+     **************************************************************************************************/
+    class PositionState
+    {
+        public:
+            /** @brief Constructs an empty position (no pieces, Light to move). */
+            PositionState() = default;
+
+            /***************************************************************************
+             * @brief Takes a snapshot of a Board.
+             * @param board The Board to copy the pieces and position state from.
+             * @param halfmove_clock Half moves since the last capture or pawn move.
+             * @param fullmove_number The full move number, starting at 1.
+             **************************************************************************/
+            explicit PositionState(const Board &board, int halfmove_clock = 0, int fullmove_number = 1);
+
+            /*******************************************************************************************
+             * @brief Returns the position after a move, this position is left unchanged.
+             *
+             * The move is trusted to be legal in this position, as with Board::MakeMove. The castling
+             * rights, en passant target, move counters and Zobrist key are updated the same way Board
+             * updates them, so the keys of a PositionState and a Board in the same position match.
+             *
+             * @param move The move to make.
+             * @return The PositionState after the move.
+             ******************************************************************************************/
+            PositionState MakeMove(const Move &move) const;
+
+            /*********************************************************************************
+             * @brief Returns the piece on a square.
+             * @param square The square (0-63).
+             * @return The piece index (Bitboards::PieceIndex) of the piece, or Bitboards::NO_PIECE.
+             ********************************************************************************/
+            int GetPieceAt(int square) const;
+
+            /** @brief Returns the squares holding a piece of the given color and type. */
+            Bitboard GetPieceBitboard(Enums::Color color, Enums::PieceType piece_type) const;
+
+            /** @brief Returns the squares holding a piece of the given color. */
+            Bitboard GetColorBitboard(Enums::Color color) const;
+
+            /** @brief Returns the squares holding any piece. */
+            Bitboard GetOccupiedBitboard() const;
+
+            /** @brief Returns the color of the player whose turn it is. */
+            Enums::Color GetSideToMove() const;
+
+            /** @brief Returns the castling rights, a combination of the Constants::CASTLE_* bits. */
+            int GetCastlingRights() const;
+
+            /** @brief Returns the en passant target square, or Bitboards::NO_SQUARE. */
+            int GetEnPassantSquare() const;
+
+            /** @brief Returns the half moves since the last capture or pawn move. */
+            int GetHalfmoveClock() const;
+
+            /** @brief Returns the full move number. */
+            int GetFullmoveNumber() const;
+
+            /** @brief Returns the Zobrist key of the position. */
+            ZobristKey GetZobristKey() const;
+
+        private:
+            /** @brief One Bitboard per (color, piece type), indexed by Bitboards::PieceIndex. */
+            std::array<Bitboard, Bitboards::PIECE_COUNT> piece_bitboards_{};
+
+            /** @brief The occupancy of each color, indexed by Bitboards::ColorIndex. */
+            std::array<Bitboard, 2> color_bitboards_{};
+
+            /** @brief The Zobrist key of the position. */
+            ZobristKey zobrist_key_ = 0;
+
+            /** @brief The piece index on each square, or Bitboards::NO_PIECE. */
+            std::array<std::uint8_t, Bitboards::SQUARE_COUNT> squares_ = MakeEmptySquares();
+
+            /** @brief Half moves since the last capture or pawn move. */
+            std::uint16_t halfmove_clock_ = 0;
+
+            /** @brief The full move number, incremented after Dark moves. */
+            std::uint16_t fullmove_number_ = 1;
+
+            /** @brief The color index (Bitboards::ColorIndex) of the side to move. */
+            std::uint8_t side_to_move_ = 0;
+
+            /** @brief The castling rights, a combination of the Constants::CASTLE_* bits. */
+            std::uint8_t castling_rights_ = 0;
+
+            /** @brief The en passant target square, or Bitboards::NO_SQUARE. */
+            std::int8_t en_passant_square_ = Bitboards::NO_SQUARE;
+
+            /** @brief Returns a square table with every square empty. */
+            static constexpr std::array<std::uint8_t, Bitboards::SQUARE_COUNT> MakeEmptySquares()
+            {
+                std::array<std::uint8_t, Bitboards::SQUARE_COUNT> squares{};
+                for (std::uint8_t &square : squares)
+                {
+                    square = static_cast<std::uint8_t>(Bitboards::NO_PIECE);
+                }
+                return squares;
+            }
+
+            /** @brief Adds or removes a piece on a square in the Bitboards, square table and Zobrist key. */
+            void TogglePiece(int piece_index, int square);
+
+            /** @brief Moves a piece from its square to an empty square, see TogglePiece. */
+            void MovePiece(int piece_index, int from_square, int to_square);
+
+            /** @brief Returns the en passant part of the Zobrist key (0 if no pawn can capture en passant). */
+            ZobristKey GetEnPassantZobristKey() const;
+    };
+
+    static_assert(std::is_trivially_copyable_v<PositionState>, "PositionState must stay plain data");
+    static_assert(sizeof(PositionState) < 200, "PositionState must stay under 200 bytes");
+} // namespace GameLogic
+
+#endif
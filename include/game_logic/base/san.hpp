@@ -0,0 +1,56 @@
+#ifndef GAMELOGIC_SAN_HPP
+#define GAMELOGIC_SAN_HPP
+
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/move.hpp"
+
+#include <cstddef>
+
+namespace GameLogic
+{
+    namespace San
+    {
+        /** @brief A buffer of this size holds any SAN move WriteSan produces ("Qh4xe1#", "exd8=Q+"). */
+        inline constexpr std::size_t MAX_SAN_LENGTH = 8;
+
+        /*****************************************************************************************************
+         * @brief Writes a move in Standard Algebraic Notation, without the check or mate mark.
+         *
+         * The move is disambiguated with the attack tables: only the other pieces of the same type that
+         * attack the destination square are looked at, and only those are tested for pins. No legal move
+         * list is generated.
+         *
+         * @param board The Board in the position before the move, it is not modified.
+         * @param move The legal move to write.
+         * @param buffer The buffer the SAN is written into, at least MAX_SAN_LENGTH characters. No null is
+         *               written.
+         * @return The number of characters written.
+         ****************************************************************************************************/
+        std::size_t WriteSanMove(Board &board, const Move &move, char *buffer);
+
+        /*****************************************************************************************************
+         * @brief Returns the check or mate mark of the position after a move.
+         *
+         * The legal moves are only generated when the side to move is in check, to tell check from mate.
+         *
+         * @param board The Board in the position after the move.
+         * @return '#' for checkmate, '+' for check, or '\0' if the side to move is not in check.
+         ****************************************************************************************************/
+        char GetCheckMark(Board &board);
+
+        /*****************************************************************************************************
+         * @brief Writes a move in Standard Algebraic Notation, with its check or mate mark.
+         *
+         * The move is made and unmade on the Board to find the mark, the Board ends up where it started.
+         *
+         * @param board The Board in the position before the move.
+         * @param move The legal move to write.
+         * @param buffer The buffer the SAN is written into, at least MAX_SAN_LENGTH characters. No null is
+         *               written.
+         * @return The number of characters written.
+         ****************************************************************************************************/
+        std::size_t WriteSan(Board &board, const Move &move, char *buffer);
+    } // namespace San
+} // namespace GameLogic
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef GAMELOGIC_ZOBRIST_HPP
+#define GAMELOGIC_ZOBRIST_HPP
+
+#include "game_logic/enums.hpp"
+
+#include <cstdint>
+
+namespace GameLogic
+{
+    /*****************************************************************************************
+     * @brief A 64 bit hash of a position (pieces, side to move, castling rights, en passant).
+     *
+     * The key is the XOR of one random number per feature of the position, so a move only
+     * has to XOR in and out the features it changes. Two positions with the same key are
+     * treated as the same position for repetition detection.
+     ****************************************************************************************/
+    using ZobristKey = std::uint64_t;
+
+    namespace Zobrist
+    {
+        /********************************************************************
+         * @brief Returns the key of a piece standing on a square.
+         * @param color The color of the piece.
+         * @param piece_type The type of the piece (Pawn, Knight, ...).
+         * @param square The square (0-63) the piece is on.
+         * @return The random key for that (color, piece type, square).
+         *******************************************************************/
+        ZobristKey PieceKey(Enums::Color color, Enums::PieceType piece_type, int square);
+
+        /*********************************************************************************
+         * @brief Returns the key of a castling rights mask.
+         * @param castling_rights A combination of the Constants::CASTLE_* bits (0-15).
+         * @return The random key for that castling rights mask.
+         ********************************************************************************/
+        ZobristKey CastlingKey(int castling_rights);
+
+        /** @brief Returns the key of an en passant target on the given col (0-7). */
+        ZobristKey EnPassantKey(int col);
+
+        /** @brief Returns the key XORed in whenever Dark is the side to move. */
+        ZobristKey SideKey();
+    } // namespace Zobrist
+} // namespace GameLogic
+
+#endif
@@ -21,6 +21,9 @@ namespace GameLogic
         /** @brief The Number of rows on a standard board. */
         inline constexpr int RANK = 8;
 
+        /** @brief The capacity of a MoveList, above the 218 legal moves of the richest known position. */
+        inline constexpr int MAX_MOVES = 256;
+
         // -- Castling Offsets -- //
 
         /** @brief The column distance from the king's start position to the king side rooks start position. */
@@ -38,6 +41,18 @@ namespace GameLogic
         /** @brief The number of empty columns between the King and the Queen side rook. */
         inline constexpr int QUEEN_SIDE_EMPTY_COUNT = 3;
 
+        // -- Castling Rights -- //
+
+        /** @brief One bit per castling right, combined into a single castling rights mask. */
+        inline constexpr int CASTLE_LIGHT_KS = 1;
+        inline constexpr int CASTLE_LIGHT_QS = 2;
+        inline constexpr int CASTLE_DARK_KS = 4;
+        inline constexpr int CASTLE_DARK_QS = 8;
+
+        /** @brief No castling right left, or every castling right available. */
+        inline constexpr int CASTLE_NONE = 0;
+        inline constexpr int CASTLE_ALL = CASTLE_LIGHT_KS | CASTLE_LIGHT_QS | CASTLE_DARK_KS | CASTLE_DARK_QS;
+
         // -- Collection of Enums -- //
 
         /** @brief Possible sides or colors of the game. */
@@ -4,12 +4,16 @@
 #include "game_logic/base/board.hpp"
 #include "game_logic/base/player.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/move_record.hpp"
 #include "game_logic/base/position.hpp"
+#include "game_logic/base/position_state.hpp"
 #include "game_logic/base/game_result.hpp"
+#include "game_logic/base/zobrist.hpp"
 
 #include "game_logic/enums.hpp"
 
+#include <cstddef>
 #include <map>
 #include <vector>
 #include <memory>
@@ -33,10 +37,20 @@ namespace GameLogic
             /** @brief Default Destrcutor */
             ~Game() = default;
 
+            /*****************************************************************************************
+             * @brief Returns every legal move of the current player.
+             *
+             * The moves are generated once per position and cached under the position's Zobrist key,
+             * the cache is dropped whenever a move is executed, undone or redone.
+             *
+             * @return A const reference to the cached MoveList, valid until the position changes.
+             ****************************************************************************************/
+            const MoveList &GetLegalMoves();
+
             /************************************************************************************************
              * @brief Calculates and returns all legal moves a specific piece can make from a given position.
              * @param position The starting position of the piece.
-             * @return A vector of valid Move objects.
+             * @return A vector of valid Move objects, filtered from GetLegalMoves.
              ***********************************************************************************************/
             std::vector<Move> GetLegalMovesAtPosition(const Position &position);
 
@@ -47,6 +61,13 @@ namespace GameLogic
              *****************************************************************/
             std::vector<Move> GetAllLegalMovesForPlayer(Enums::Color player_color);
 
+            /************************************************************************
+             * @brief Appends all legal moves a player can make to a MoveList.
+             * @param player_color The color of the player.
+             * @param legal_moves The MoveList the legal moves are appended to.
+             ***********************************************************************/
+            void GetAllLegalMovesForPlayer(Enums::Color player_color, MoveList &legal_moves);
+
             /*******************************************************************************************
              * @brief Provides a read only map of all pieces currently on the board and their positions.
              * @return An immutable map of Position to const Piece pointers.
@@ -59,6 +80,22 @@ namespace GameLogic
              **************************************************************************/
             bool IsGameOver() const;
 
+            /****************************************************************************************
+             * @brief Check if the current position has occurred three or more times.
+             *
+             * Only positions with the same side to move since the last capture or pawn move are
+             * compared, since no earlier position can occur again.
+             *
+             * @return true if threefold repetition has occurred.
+             ***************************************************************************************/
+            bool IsThreefoldRepetition() const;
+
+            /****************************************************************************************
+             * @brief Check if there is insufficient material for checkmate.
+             * @return true if neither side can checkmate.
+             ***************************************************************************************/
+            bool IsInsufficientMaterial() const;
+
             /**********************************************************************************************
              * @brief Attempts to execute a given move for the current player.
              *
@@ -82,6 +119,73 @@ namespace GameLogic
              ***********************************************************************************/
             std::string GenerateFen() const;
 
+            /********************************************************************************************
+             * @brief Same as GenerateFen above, but writes into a caller supplied buffer so that no heap
+             *        memory is allocated.
+             * @param buffer The buffer the null terminated FEN is written into.
+             * @param buffer_size The size of the buffer, at least Fen::MAX_FEN_LENGTH.
+             * @return The length of the FEN, not counting the terminating null.
+             *******************************************************************************************/
+            std::size_t GenerateFen(char *buffer, std::size_t buffer_size) const;
+
+            /********************************************************************************************
+             * @brief Set up the game from a position in Forsyth–Edwards Notation (FEN).
+             *
+             * The undo and redo histories are cleared and the loaded position becomes the first entry
+             * of the repetition history. The game is left unchanged if the FEN is malformed.
+             *
+             * @param fen The position in FEN notation.
+             * @throws std::invalid_argument If the FEN is malformed.
+             *******************************************************************************************/
+            void LoadFen(const std::string &fen);
+
+            /********************************************************************************************
+             * @brief Returns a buffer size that ExportPgn is guaranteed to fit in for the moves so far.
+             * @return The size in characters, including the terminating null.
+             *******************************************************************************************/
+            std::size_t GetPgnBufferSize() const;
+
+            /********************************************************************************************
+             * @brief Writes the game as PGN into a caller supplied buffer so that no heap memory is
+             *        allocated.
+             *
+             * The seven tag roster is written with unknown values, plus SetUp and FEN tags if the game
+             * did not start from the standard position. The moves of the undo history follow in SAN,
+             * wrapped to lines under 80 characters, then the result. SAN moves are disambiguated with
+             * the attack tables (see San::WriteSanMove), legal moves are only generated to tell check
+             * from mate.
+             *
+             * @param buffer The buffer the null terminated PGN is written into.
+             * @param buffer_size The size of the buffer, at least GetPgnBufferSize().
+             * @return The length of the PGN, not counting the terminating null.
+             * @throws std::length_error If the buffer is smaller than GetPgnBufferSize().
+             *******************************************************************************************/
+            std::size_t ExportPgn(char *buffer, std::size_t buffer_size) const;
+
+            /********************************************************************************************
+             * @brief Takes a copyable snapshot of the current position, including the move counters.
+             * @return A PositionState that can be handed to another thread.
+             *******************************************************************************************/
+            PositionState GetPositionState() const;
+
+            /*****************************************************************************************
+             * @brief Get the position the move history starts from, set by Reset and LoadFen.
+             * @return A const reference to the start position, with its move counters.
+             ****************************************************************************************/
+            const PositionState &GetStartPosition() const;
+
+            /*****************************************************************************************
+             * @brief Check if the move history starts from the standard starting position.
+             * @return true if the game was not set up from another FEN position.
+             ****************************************************************************************/
+            bool StartsFromStandardPosition() const;
+
+            /*****************************************************************************************
+             * @brief Get the moves executed so far, oldest first (the undo history).
+             * @return A const reference to the MoveRecords of the executed moves.
+             ****************************************************************************************/
+            const std::vector<MoveRecord> &GetMoveHistory() const;
+
             /*************************************************************************************************************
              * @brief Gets a pointer to the most recently executed move.
              * @return A const pointer to the last Move object in the undo history, or nullptr if no moves have been made.
@@ -100,6 +204,12 @@ namespace GameLogic
              **********************************************************************/
             const Player &GetOpponentPlayer() const;
 
+            /*********************************************************************************
+             * @brief Get a const reference to the board, to read the position without copying.
+             * @return A const reference to the Board.
+             ********************************************************************************/
+            const Board &GetBoard() const;
+
             /***********************************************************************
              * @brief Get a const reference to the game result.
              * @return A const reference to the GameResult object.
@@ -146,17 +256,28 @@ namespace GameLogic
             /** @brief History of moves undoed, used for redo. */
             std::vector<MoveRecord> redo_history_;
 
-            /** @brief Stores existing board states for three fold repetition. */
-            std::map<std::string, int> board_states_;
-
             /** @brief Tracks half moves since the last capture or pawn move for the fifty-move draw rule. */
             int fifty_move_counter_;
 
             /** @brief The total number of full moves made */
             int full_move_counter_;
 
-            /** @brief History of board positions represented as strings for threefold repetition. */
-            std::vector<std::string> position_history_;
+            /** @brief Zobrist keys of every position reached in the game (including the start), for threefold repetition. */
+            std::vector<ZobristKey> position_history_;
+
+            /** @brief The position the undo history starts from, for exporting the game. */
+            PositionState start_position_;
+
+            // -- Legal Move Cache -- //
+
+            /** @brief The legal moves of the current player, valid while legal_moves_cached_ is set. */
+            MoveList legal_moves_;
+
+            /** @brief The Zobrist key of the position legal_moves_ was generated for. */
+            ZobristKey legal_moves_key_;
+
+            /** @brief true if legal_moves_ holds the moves of the position with legal_moves_key_. */
+            bool legal_moves_cached_;
 
             // -- Game Outcome -- //
 
@@ -178,85 +299,6 @@ namespace GameLogic
              * @param is_pawn_move true if the move was a pawn move, false otherwise.
              ***************************************************************************************/
             void UpdateFiftyMoveCounter(bool is_pawn_move, bool is_capture_move);
-
-            /****************************************************************************************
-             * @brief Check if the current position has occurred three or more times.
-             * @return true if threefold repetition has occurred.
-             ***************************************************************************************/
-            bool IsThreefoldRepetition() const;
-
-            /****************************************************************************************
-             * @brief Check if there is insufficient material for checkmate.
-             * @return true if neither side can checkmate.
-             ***************************************************************************************/
-            bool IsInsufficientMaterial() const;
-
-
-            // --- FEN Generation Helpers ---
-
-            /******************************************************************************************
-             * @brief Generates the FEN representation of the board's piece placement (Part 1 of FEN).
-             *
-             * Iterates over all 8 ranks (rows) from top to bottom, using numbers for empty squares
-             * and piece characters (case sensitive for color). Ranks are separated by '/'.
-             * Example: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR" (the starting state of the board)
-             *
-             * @return The FEN piece placement string.
-             *****************************************************************************************/
-            std::string GenerateFenPiecePlacement() const;
-
-            /*********************************************************************************
-             * @brief Generates the FEN representation of the active color (Part 2 of FEN).
-             *
-             * Returns 'w' if it is Light's turn to move, or 'b' if it is Dark's turn to move.
-             * Example: "w"
-             *
-             * @return The FEN active color character as a string.
-             ********************************************************************************/
-            std::string GenerateFenActiveColor() const;
-
-            /***********************************************************************************
-             * @brief Generates the FEN representation of castling availability (Part 3 of FEN).
-             *
-             * Returns "KQkq" if all castling moves are available, or a subset based on which
-             * kings/rooks have moved. Returns '-' if no castling is possible.
-             * Example: "KQ" or "-"
-             *
-             * @return The FEN castling availability string.
-             **********************************************************************************/
-            std::string GenerateFenCastlingRights() const;
-
-            /******************************************************************************************
-             * @brief Generates the FEN representation of the en passant target square (Part 4 of FEN).
-             *
-             * Returns the algebraic notation of the square immediately behind the destination
-             * of the last double pawn move. Returns '-' otherwise.
-             * Example: "e3" or "-"
-             *
-             * @return The FEN en passant target square string.
-             ******************************************************************************************/
-            std::string GenerateFenEnPassantSquare() const;
-
-            /**************************************************************************************
-             * @brief Generates the FEN representation of the halfmove clock (Part 5 of FEN).
-             *
-             * This counter tracks the number of half-moves since the last pawn advance or capture,
-             * used for the 50-move draw rule.
-             * Example: "0" or "15"
-             *
-             * @return The FEN halfmove clock value as a string.
-             *************************************************************************************/
-            std::string GenerateFenHalfmoveClock() const;
-
-            /******************************************************************************************
-             * @brief Generates the FEN representation of the fullmove number (Part 6 of FEN).
-             *
-             * The move number starts at 1 and is incremented after every full move pair (White+Black).
-             * Example: "1" or "42"
-             *
-             * @return The FEN fullmove number value as a string.
-             *****************************************************************************************/
-            std::string GenerateFenFullmoveNumber() const;
     };
 }
 
@@ -0,0 +1,187 @@
+#ifndef GAMELOGIC_ARCHIVE_HPP
+#define GAMELOGIC_ARCHIVE_HPP
+
+#include "game_logic/game.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
+#include "game_logic/replay/replay.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace GameLogic
+{
+    /*****************************************************************************************************
+     * @brief A compact binary archive of Game histories, one byte per move.
+     *
+     * A move is stored as its index in the legal moves of its position, sorted by start square, then
+     * destination square, then promotion piece (queen, rook, bishop, knight). The order only depends
+     * on the position, so any reader that generates the same legal moves decodes the same game.
+     *
+     * Layout (integers are little endian):
+     *   File header   "SCGA", u16 version, u16 reserved (0)
+     *   Game          u16 ply count, u8 result, u8 FEN length (0 for the standard start position),
+     *                 the FEN, then one byte per ply
+     *   Index         u64 offset of every game from the start of the file
+     *   Footer        u64 game count, "SCGI"
+     ****************************************************************************************************/
+    namespace Archive
+    {
+        /** @brief The first four bytes of every archive. */
+        inline constexpr char ARCHIVE_MAGIC[4] = {'S', 'C', 'G', 'A'};
+
+        /** @brief The last four bytes of every archive, after the game offset index. */
+        inline constexpr char INDEX_MAGIC[4] = {'S', 'C', 'G', 'I'};
+
+        /** @brief The format version written in the file header. */
+        inline constexpr std::uint16_t ARCHIVE_VERSION = 1;
+
+        /** @brief The size of the file header in bytes. */
+        inline constexpr std::size_t HEADER_SIZE = 8;
+
+        /** @brief The size of the footer in bytes. */
+        inline constexpr std::size_t FOOTER_SIZE = 12;
+
+        /*************************************************************************************************
+         * @brief Encodes a move as its index in the sorted legal moves of its position.
+         * @param move The legal move, a promotion without a promotion piece counts as a queen.
+         * @param legal_moves The legal moves of the position, in any order.
+         * @return The index of the move.
+         * @throws std::invalid_argument If the move is not in legal_moves.
+         ************************************************************************************************/
+        std::uint8_t EncodeMove(const Move &move, const MoveList &legal_moves);
+
+        /*************************************************************************************************
+         * @brief Decodes a move from its index in the sorted legal moves of its position.
+         * @param index The index written by EncodeMove.
+         * @param legal_moves The legal moves of the position, in any order.
+         * @param move Set to the move, with its promotion piece.
+         * @return true if the index is in range.
+         ************************************************************************************************/
+        bool DecodeMove(std::uint8_t index, const MoveList &legal_moves, Move &move);
+
+        /*************************************************************************************************
+         * @class ArchiveWriter
+         * @brief Appends Game histories to an archive on an output stream.
+         *
+         * The file header is written on construction and the offset index and footer by Finish, which
+         * the destructor calls if it was not called before. The stream should be opened in binary mode.
+         ************************************************************************************************/
+        class ArchiveWriter
+        {
+            public:
+                /** @brief Writes the file header to a stream, which must outlive the writer. */
+                explicit ArchiveWriter(std::ostream &stream);
+
+                /** @brief Writes the index and footer if Finish was not called. */
+                ~ArchiveWriter();
+
+                ArchiveWriter(const ArchiveWriter &) = delete;
+                ArchiveWriter &operator=(const ArchiveWriter &) = delete;
+
+                /*****************************************************************************************
+                 * @brief Appends a Game's history, from its start position to its current position.
+                 * @param game The Game to write.
+                 * @throws std::length_error If the game has more than 65535 plies.
+                 ****************************************************************************************/
+                void WriteGame(const Game &game);
+
+                /** @brief Writes the game offset index and footer, no game can be written after it. */
+                void Finish();
+
+                /** @brief Returns the number of games written. */
+                std::size_t GetGameCount() const;
+
+            private:
+                /** @brief The stream the archive is written to. */
+                std::ostream &stream_;
+
+                /** @brief The number of bytes written so far, the offset of the next game. */
+                std::uint64_t offset_;
+
+                /** @brief The offset of every game written. */
+                std::vector<std::uint64_t> game_offsets_;
+
+                /** @brief The bytes of the game being written, reused between games. */
+                std::vector<char> game_bytes_;
+
+                /** @brief A scratch Board the history is replayed on to find each move's index. */
+                Board board_;
+
+                /** @brief The legal moves of the scratch Board's position. */
+                MoveList legal_moves_;
+
+                /** @brief true once the index and footer are written. */
+                bool is_finished_;
+        };
+
+        /*************************************************************************************************
+         * @class ArchiveReader
+         * @brief Reads the games of an archive in place, in order or by game number.
+         *
+         * Every game is rebuilt through Game::ExecuteMove, so the Game ends up with the full undo
+         * history, repetition history and result of the recorded game.
+         ************************************************************************************************/
+        class ArchiveReader
+        {
+            public:
+                /*****************************************************************************************
+                 * @brief Constructs a reader over an archive, usually the contents of a MappedFile.
+                 * @param data The archive, which must outlive the reader.
+                 * @throws std::runtime_error If the header, footer or index is missing or malformed.
+                 ****************************************************************************************/
+                explicit ArchiveReader(std::string_view data);
+
+                /*****************************************************************************************
+                 * @brief Rebuilds the next game.
+                 * @param game The Game to rebuild the game in, it is reset or set up from the game's FEN.
+                 * @return true if a game was read, false after the last game.
+                 * @throws std::runtime_error If the game is malformed or does not match its result.
+                 ****************************************************************************************/
+                bool ReadGame(Game &game);
+
+                /*****************************************************************************************
+                 * @brief Moves to a game through the offset index, the next ReadGame reads it.
+                 * @param game_index The index of the game, starting at 0.
+                 * @throws std::out_of_range If there is no such game.
+                 ****************************************************************************************/
+                void SeekGame(std::size_t game_index);
+
+                /** @brief Returns the number of games in the archive. */
+                std::size_t GetGameCount() const;
+
+            private:
+                /** @brief The archive. */
+                std::string_view data_;
+
+                /** @brief The index of the next game to read. */
+                std::size_t game_index_;
+
+                /** @brief The number of games in the archive. */
+                std::size_t game_count_;
+
+                /** @brief The start of the game offset index, which is also the end of the last game. */
+                std::size_t index_offset_;
+
+                /** @brief Returns the offset of a game, read from the index. */
+                std::size_t GetGameOffset(std::size_t game_index) const;
+        };
+
+        /*************************************************************************************************
+         * @brief Rebuilds every game of an archive, in order.
+         * @param data The archive.
+         * @param on_game Called with the rebuilt Game and the outcome of every game.
+         * @return The totals over every game.
+         * @throws std::runtime_error If the archive is malformed.
+         ************************************************************************************************/
+        Replay::ReplaySummary ReplayArchive(std::string_view data,
+                                            const std::function<void(const Game &, const Replay::GameReplay &)> &on_game);
+    } // namespace Archive
+} // namespace GameLogic
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef GAMELOGIC_MAPPED_FILE_HPP
+#define GAMELOGIC_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace GameLogic
+{
+    /***************************************************************************************************
+     * @class MappedFile
+     * @brief Maps a whole file read only into memory.
+     *
+     * The contents are read straight out of the page cache, so parsers can hand out std::string_view
+     * tokens into the file instead of copying lines into strings. The views stay valid for as long as
+     * the MappedFile is alive.
+     **************************************************************************************************/
+    class MappedFile
+    {
+        public:
+            /*************************************************************************
+             * @brief Maps a file into memory.
+             * @param path The path of the file.
+             * @throws std::runtime_error If the file cannot be opened or mapped.
+             ************************************************************************/
+            explicit MappedFile(const std::string &path);
+
+            /** @brief Unmaps the file. */
+            ~MappedFile();
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            /** @brief Returns the contents of the file, empty for an empty file. */
+            std::string_view GetContents() const;
+
+            /** @brief Returns the size of the file in bytes. */
+            std::size_t GetSize() const;
+
+        private:
+            /** @brief The first byte of the mapping, nullptr for an empty file. */
+            const char *data_;
+
+            /** @brief The size of the file in bytes. */
+            std::size_t size_;
+    };
+} // namespace GameLogic
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef GAMELOGIC_PGN_HPP
+#define GAMELOGIC_PGN_HPP
+
+#include "game_logic/game.hpp"
+#include "game_logic/replay/replay.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace GameLogic
+{
+    namespace Pgn
+    {
+        /** @brief A tag pair of a PGN header, such as [White "Carlsen, Magnus"]. */
+        struct PgnTag
+        {
+            /** @brief The tag name, such as "White". */
+            std::string_view name;
+
+            /** @brief The tag value without its quotes, escapes (\" and \\) are left as written. */
+            std::string_view value;
+        };
+
+        /*********************************************************************************************
+         * @brief One game of a PGN file: its tag pairs and movetext.
+         *
+         * The views point into the PGN text. A PgnGame is meant to be reused from game to game, the
+         * tag vector then keeps its capacity and reading a game allocates nothing.
+         ********************************************************************************************/
+        struct PgnGame
+        {
+            /** @brief The byte offset of the game in the PGN text. */
+            std::size_t offset = 0;
+
+            /** @brief The tag pairs in the order they are written. */
+            std::vector<PgnTag> tags;
+
+            /** @brief The movetext, up to and including the game termination marker. */
+            std::string_view movetext;
+
+            /** @brief Returns the value of a tag, empty if the game has no such tag. */
+            std::string_view GetTag(std::string_view name) const;
+        };
+
+        /*********************************************************************************************
+         * @class PgnReader
+         * @brief Reads the games of a PGN text one at a time, in place.
+         *
+         * A game is its tag pairs followed by its movetext, which ends at the game termination marker
+         * ("1-0", "0-1", "1/2-1/2", "*"). A game missing its marker ends where the next tag section
+         * starts. Comments, variations and annotation glyphs are skipped with Replay::NextMoveToken.
+         ********************************************************************************************/
+        class PgnReader
+        {
+            public:
+                /*******************************************************************
+                 * @brief Constructs a reader over a PGN text.
+                 * @param text The PGN text, usually the contents of a MappedFile.
+                 * @param offset The byte offset to start reading at, a game start.
+                 ******************************************************************/
+                explicit PgnReader(std::string_view text, std::size_t offset = 0);
+
+                /*****************************************************************
+                 * @brief Reads the next game.
+                 * @param game Filled in with the game, its tags are replaced.
+                 * @return true if a game was read, false at the end of the text.
+                 ****************************************************************/
+                bool ReadGame(PgnGame &game);
+
+                /** @brief Returns the byte offset the next game is read from. */
+                std::size_t GetOffset() const;
+
+            private:
+                /** @brief The PGN text. */
+                std::string_view text_;
+
+                /** @brief The byte offset the next game is read from. */
+                std::size_t index_;
+
+                /** @brief Moves the index past whitespace and escaped ('%') lines. */
+                void SkipWhitespace();
+
+                /** @brief Reads the tag pair at the index into a game and moves to the next line. */
+                void ReadTag(PgnGame &game);
+        };
+
+        /*********************************************************************************************
+         * @brief Finds the byte offset of every game of a PGN text.
+         *
+         * Only the start of each line is looked at: a game starts at a tag line ('[Name "') that
+         * follows movetext, and the movetext is not tokenized. A game after the first one must
+         * therefore start with its tags, as in export format PGN.
+         *
+         * @param text The PGN text.
+         * @return The offsets in order, each one can be handed to a PgnReader.
+         ********************************************************************************************/
+        std::vector<std::size_t> IndexGames(std::string_view text);
+
+        /*********************************************************************************************
+         * @brief Sets up a Game for a PGN game: the position of its FEN tag, or the starting position.
+         * @param pgn_game The PGN game.
+         * @param game The Game to set up.
+         * @return true if the game could be set up, false if its FEN tag is malformed.
+         ********************************************************************************************/
+        bool SetUpGame(const PgnGame &pgn_game, Game &game);
+
+        /*********************************************************************************************
+         * @brief Replays every game of a PGN text, spread over worker threads.
+         *
+         * The games are found with IndexGames first, then worker threads take batches of games and
+         * each reads and replays them in its own Game. on_game is called for every game under a lock,
+         * so it needs no locking of its own, but with more than one thread the games arrive out of
+         * order: use the game_number of the GameReplay (its position in the file, starting at 1) to
+         * order them.
+         *
+         * @param text The PGN text, usually the contents of a MappedFile.
+         * @param thread_count The number of worker threads, 1 replays on the calling thread.
+         * @param on_game Called with every game, the Game in the position its replay stopped in and
+         *                the outcome of replaying it.
+         * @return The totals over every game, elapsed summing the time of every thread.
+         ********************************************************************************************/
+        Replay::ReplaySummary ReplayPgn(std::string_view text, unsigned int thread_count,
+                                        const std::function<void(const PgnGame &, const Game &, const Replay::GameReplay &)> &on_game);
+    } // namespace Pgn
+} // namespace GameLogic
+
+#endif
@@ -46,11 +46,11 @@ namespace GameLogic
              *
              * @param from_position The starting position of the Bishop.
              * @param board The current state of the board for validation.
+             * @param moves The MoveList the potential moves are appended to.
              * @param last_move Optional pointer to the last move made in the game (not typically used by Bishops).
-             * @return A vector of potential Move objects.
              **************************************************************************************************************************/
-            std::vector<Move> GetPotentialMoves(
-                const Position &from_position, const Board &board, const Move* last_move = nullptr) const override;
+            void GeneratePotentialMoves(
+                const Position &from_position, const Board &board, MoveList &moves, const Move* last_move = nullptr) const override;
     };
 } // namespace GameLogic
 
@@ -35,7 +35,7 @@ namespace GameLogic
             // 3) Captures: check two diagonal targets; include if enemy there.
             // 4) Promotion / en passant handled later.
             // !!! Does not check king safety
-            std::vector<Move> GetPotentialMoves(const Position& from_position, const Board &board, const Move* last_move = nullptr) const override;
+            void GeneratePotentialMoves(const Position& from_position, const Board &board, MoveList &moves, const Move* last_move = nullptr) const override;
 
             std::vector<Position> GetForwardPositions(const Position &from_position, const Board &board) const;
 
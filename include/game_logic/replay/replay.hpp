@@ -0,0 +1,125 @@
+#ifndef GAMELOGIC_REPLAY_HPP
+#define GAMELOGIC_REPLAY_HPP
+
+#include "game_logic/game.hpp"
+#include "game_logic/base/fen.hpp"
+#include "game_logic/base/game_result.hpp"
+#include "game_logic/base/move.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace GameLogic
+{
+    namespace Replay
+    {
+        /*********************************************************************************************
+         * @brief The outcome of replaying one game.
+         *
+         * The string views point into the text the game was read from, nothing is copied out of it.
+         ********************************************************************************************/
+        struct GameReplay
+        {
+            /** @brief The number of the game in the stream, starting at 1. */
+            std::size_t game_number;
+
+            /** @brief The number of half moves executed. */
+            int ply_count;
+
+            /** @brief true if every move of the game was legal. */
+            bool is_valid;
+
+            /** @brief The first move that could not be played, empty if the game is valid. */
+            std::string_view bad_move;
+
+            /** @brief The result written after the moves ("1-0", "0-1", "1/2-1/2", "*"), empty if there is none. */
+            std::string_view declared_result;
+
+            /** @brief The result of the position the replay stopped in. */
+            GameResult result;
+
+            /** @brief The FEN of the position the replay stopped in. */
+            char final_fen[Fen::MAX_FEN_LENGTH];
+
+            /** @brief The time spent replaying the game. */
+            std::chrono::nanoseconds elapsed;
+        };
+
+        /** @brief Totals over every game of a stream. */
+        struct ReplaySummary
+        {
+            /** @brief The number of games replayed. */
+            std::size_t game_count;
+
+            /** @brief The number of games with a move that could not be played. */
+            std::size_t invalid_count;
+
+            /** @brief The number of half moves executed over every game. */
+            std::uint64_t ply_count;
+
+            /** @brief The time spent replaying every game, not counting the callback. */
+            std::chrono::nanoseconds elapsed;
+        };
+
+        /*********************************************************************************************
+         * @brief Finds the legal move of the current player written by a move token.
+         *
+         * The token is either UCI ("e2e4", "e7e8q") or Standard Algebraic Notation ("e4", "Nbd7",
+         * "exd6", "e8=Q+", "O-O"). Check and annotation marks at the end of a SAN move are ignored.
+         *
+         * @param token The move text.
+         * @param game The Game whose current position the move is played in.
+         * @param move Set to the legal move, with its promotion piece, if one is found.
+         * @return true if exactly one legal move matches the token.
+         ********************************************************************************************/
+        bool FindMove(std::string_view token, Game &game, Move &move);
+
+        /*********************************************************************************************
+         * @brief Returns the next move or result token of a game's movetext.
+         *
+         * Whitespace, move numbers ("12." or "12..."), comments ("{...}" and "; ..." to the end of the
+         * line), variations ("(...)", nested) and numeric annotation glyphs ("$1") are skipped.
+         *
+         * @param text The movetext.
+         * @param index The position to read from, moved past the token.
+         * @return A view of the token inside text, empty at the end of the text.
+         ********************************************************************************************/
+        std::string_view NextMoveToken(std::string_view text, std::size_t &index);
+
+        /** @brief Returns true if a token is a game termination marker ("1-0", "0-1", "1/2-1/2", "*"). */
+        bool IsResultToken(std::string_view token);
+
+        /*********************************************************************************************
+         * @brief Plays a game's moves through Game::ExecuteMove from the Game's current position.
+         *
+         * The moves are read with NextMoveToken and a result token ends the game. The replay stops at
+         * the first move that is not legal.
+         *
+         * @param moves The movetext of one game.
+         * @param game The Game to replay in, reset or set up by the caller so it can be reused.
+         * @param replay Filled in with the outcome, game_number is left to the caller.
+         ********************************************************************************************/
+        void ReplayGame(std::string_view moves, Game &game, GameReplay &replay);
+
+        /*********************************************************************************************
+         * @brief Replays every game of a text stream, one game per line.
+         *
+         * Empty lines and lines starting with '#' are skipped. Every game is replayed in the same
+         * Game from the standard starting position.
+         *
+         * @param text The stream, usually the contents of a MappedFile.
+         * @param on_game Called with the Game in the position the replay stopped in and the outcome of
+         *                every game, in order.
+         * @return The totals over every game.
+         ********************************************************************************************/
+        ReplaySummary ReplayStream(std::string_view text, const std::function<void(const Game &, const GameReplay &)> &on_game);
+
+        /** @brief Returns the name of a game state ("Checkmate", "Stalemate", ...). */
+        const char *GameStateToString(Enums::GameState game_state);
+    } // namespace Replay
+} // namespace GameLogic
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef GAMELOGIC_TRACE_HPP
+#define GAMELOGIC_TRACE_HPP
+
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/zobrist.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+/*****************************************************************************************************
+ * @brief The lowest trace level compiled into GameLogic: 0 Debug, 1 Info, 2 Warning, 3 Error, 4 Off.
+ *
+ * Trace calls below this level compile to nothing. Set it through the GAMELOGIC_TRACE_LEVEL CMake
+ * cache variable, e.g. -DGAMELOGIC_TRACE_LEVEL=4 removes every trace call from a release build.
+ ****************************************************************************************************/
+#ifndef GAMELOGIC_TRACE_LEVEL
+#define GAMELOGIC_TRACE_LEVEL 0
+#endif
+
+namespace GameLogic
+{
+    namespace Trace
+    {
+        /** @brief The severity of a trace event, in increasing order. */
+        enum class Level : std::uint8_t
+        {
+            Debug,
+            Info,
+            Warning,
+            Error,
+            Off
+        };
+
+        /** @brief The lowest level whose trace calls are compiled in, see GAMELOGIC_TRACE_LEVEL. */
+        inline constexpr Level COMPILED_LEVEL = static_cast<Level>(GAMELOGIC_TRACE_LEVEL);
+
+        /*********************************************************************************************
+         * @brief A structured trace event. It is plain data so a sink can copy it without allocating.
+         ********************************************************************************************/
+        struct TraceEvent
+        {
+            /** @brief The severity of the event. */
+            Level level;
+
+            /** @brief The name of the event, a string literal such as "move_executed". */
+            const char *name;
+
+            /** @brief The Move the event is about, a MoveType::None Move if there is none. */
+            Move move;
+
+            /** @brief The fifty move counter after the event. */
+            int fifty_move_counter;
+
+            /** @brief The Zobrist key of the position after the event. */
+            ZobristKey position_key;
+        };
+
+        /*********************************************************************************************
+         * @class TraceSink
+         * @brief Receives the trace events that pass the compile time and run time level filters.
+         *
+         * Write may be called from several threads at once and must not throw.
+         ********************************************************************************************/
+        class TraceSink
+        {
+            public:
+                /** @brief Default Destructor. */
+                virtual ~TraceSink() = default;
+
+                /*******************************************
+                 * @brief Records a trace event.
+                 * @param event The event to record.
+                 ******************************************/
+                virtual void Write(const TraceEvent &event) = 0;
+        };
+
+        /*********************************************************************************************
+         * @class StreamSink
+         * @brief Formats every event as one line on a std::ostream, for interactive debugging.
+         ********************************************************************************************/
+        class StreamSink : public TraceSink
+        {
+            public:
+                /** @brief Constructs a sink that writes to a stream, which must outlive the sink. */
+                explicit StreamSink(std::ostream &stream);
+
+                void Write(const TraceEvent &event) override;
+
+            private:
+                /** @brief The stream the events are written to. */
+                std::ostream &stream_;
+
+                /** @brief Keeps the lines of events written from different threads apart. */
+                std::mutex mutex_;
+        };
+
+        /*********************************************************************************************
+         * @class RingBufferSink
+         * @brief A bounded lock-free queue of trace events.
+         *
+         * Any number of threads can Write and read events at once. Every slot carries a sequence
+         * number that tells writers and readers whose turn it is, so neither side takes a lock. When
+         * the buffer is full an event is dropped and counted rather than blocking the writer, so
+         * tracing never stalls the Game.
+         ********************************************************************************************/
+        class RingBufferSink : public TraceSink
+        {
+            public:
+                /** @brief Constructs a buffer holding capacity events, rounded up to a power of two. */
+                explicit RingBufferSink(std::size_t capacity);
+
+                void Write(const TraceEvent &event) override;
+
+                /*****************************************************************
+                 * @brief Takes the oldest event out of the buffer.
+                 * @param event Set to the oldest event if there is one.
+                 * @return true if an event was read, false if the buffer is empty.
+                 ****************************************************************/
+                bool TryRead(TraceEvent &event);
+
+                /** @brief Returns the number of events dropped because the buffer was full. */
+                std::uint64_t GetDroppedCount() const;
+
+            private:
+                struct Slot
+                {
+                    /** @brief Equals the write index when the slot is free, the write index + 1 when it holds an event. */
+                    std::atomic<std::size_t> sequence;
+
+                    TraceEvent event;
+                };
+
+                std::unique_ptr<Slot[]> slots_;
+                std::size_t mask_;
+
+                /** @brief Writers and readers advance their own index, kept on separate cache lines. */
+                alignas(64) std::atomic<std::size_t> write_index_;
+                alignas(64) std::atomic<std::size_t> read_index_;
+
+                std::atomic<std::uint64_t> dropped_count_;
+        };
+
+        /*********************************************************************************************
+         * @brief Installs the sink that receives trace events, nullptr to stop tracing.
+         * @param sink The sink, which must stay alive until it is replaced. Not owned.
+         ********************************************************************************************/
+        void SetSink(TraceSink *sink);
+
+        /** @brief Sets the lowest level passed to the sink at run time (Info by default). */
+        void SetLevel(Level level);
+
+        /** @brief Returns the lowest level passed to the sink at run time. */
+        Level GetLevel();
+
+        /** @brief Returns the lowercase name of a level ("debug", "info", ...). */
+        const char *LevelName(Level level);
+
+        /** @brief Passes an event to the installed sink if its level is enabled at run time. */
+        void Write(const TraceEvent &event);
+
+        /*********************************************************************************************
+         * @brief Emits a trace event. Calls below COMPILED_LEVEL compile to nothing, the others cost a
+         *        level check and a pointer load when no sink is installed.
+         * @tparam level The severity of the event.
+         * @param name The name of the event, a string literal.
+         * @param move The Move the event is about.
+         * @param fifty_move_counter The fifty move counter after the event.
+         * @param position_key The Zobrist key of the position after the event.
+         ********************************************************************************************/
+        template <Level level>
+        inline void Emit(const char *name, const Move &move, int fifty_move_counter, ZobristKey position_key)
+        {
+            if constexpr (level >= COMPILED_LEVEL && level != Level::Off)
+            {
+                Write(TraceEvent{level, name, move, fifty_move_counter, position_key});
+            }
+        }
+    } // namespace Trace
+} // namespace GameLogic
+
+#endif
@@ -3,9 +3,13 @@
 
 #include "game_logic/base/board.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
+#include "game_logic/base/bitboard.hpp"
 
 #include "game_logic/enums.hpp"
 
+#include <vector>
+
 namespace GameLogic
 {
     /**********************************************************************************************
@@ -21,26 +25,53 @@ namespace GameLogic
             /*****************************************************************************************************************
              * @brief Determines all truly legal moves for a piece at a given position, considering king safety.
              *
-             * This function combines a piece's potential moves with validation checks (Ensures that the king is not in check)
+             * Moves are generated directly from the checkers and pinned pieces of the position, so no move is ever
+             * played on the board to test it.
              *
              * @param position The starting position of the piece.
              * @param player_color The color of the player making the move.
              * @param board The current state of the board.
-             * @param last_move A pointer to the last move made in the game (for special rules like en passant).
+             * @param last_move A pointer to the last move made in the game. Unused, en passant is read from the Board.
              * @return A vector of legal Move objects.
              ****************************************************************************************************************/
             static std::vector<Move> GetLegalMovesAtPosition(
                 const Position &position, Enums::Color player_color, Board &board, const Move *last_move);
 
+            /*****************************************************************************************
+             * @brief Same as GetLegalMovesAtPosition above, but appends into a MoveList so that no
+             *        heap memory is allocated.
+             * @param position The starting position of the piece.
+             * @param player_color The color of the player making the move.
+             * @param board The current state of the board.
+             * @param last_move A pointer to the last move made in the game. Unused, en passant is read from the Board.
+             * @param legal_moves The MoveList the legal moves are appended to.
+             ****************************************************************************************/
+            static void GetLegalMovesAtPosition(
+                const Position &position, Enums::Color player_color, const Board &board, const Move *last_move, MoveList &legal_moves);
+
             /*******************************************************************************
              * @brief Gathers all legal moves for a specific player across all their pieces.
+             *
+             * Checkers and pinned pieces are computed once for the whole position.
+             *
              * @param player_color The color of the player whose moves are being checked.
              * @param board The current state of the board.
-             * @param last_move A pointer to the last move made in the game.
+             * @param last_move A pointer to the last move made in the game. Unused, en passant is read from the Board.
              * @return A vector containing every legal Move available to the player.
              ******************************************************************************/
             static std::vector<Move> GetAllLegalMovesForPlayer(Enums::Color player_color, Board &board, const Move *last_move);
 
+            /*****************************************************************************************
+             * @brief Same as GetAllLegalMovesForPlayer above, but appends into a MoveList so that no
+             *        heap memory is allocated.
+             * @param player_color The color of the player whose moves are being checked.
+             * @param board The current state of the board.
+             * @param last_move A pointer to the last move made in the game. Unused, en passant is read from the Board.
+             * @param legal_moves The MoveList the legal moves are appended to.
+             ****************************************************************************************/
+            static void GetAllLegalMovesForPlayer(
+                Enums::Color player_color, const Board &board, const Move *last_move, MoveList &legal_moves);
+
             /**********************************************************************************************************
              * @brief Checks if a specific Move is legal for the current player for the current board state.
              * This involves a detailed check, including simulation to ensure the move doesn't leave the king in check.
@@ -53,6 +84,10 @@ namespace GameLogic
 
             /***************************************************************************************************
              * @brief Checks if a specific square on the board is currently under attack by an opponent's piece.
+             *
+             * The square is looked at from the inside out: knight, king and pawn patterns and sliding rays
+             * from the target square are intersected with the attacker's pieces.
+             *
              * @param attacker_color The color of the pieces doing the attacking.
              * @param board The current state of the board.
              * @param target_position The position being checked for attacks.
@@ -60,6 +95,34 @@ namespace GameLogic
              **************************************************************************************************/
             static bool IsSquareUnderAttack(Enums::Color attacker_color, const Board &board, const Position& target_position);
 
+            /*****************************************************************************************************
+             * @brief Finds every piece of a color that attacks a square, looking outward from the square itself.
+             * @param square The square (0-63) being attacked.
+             * @param attacker_color The color of the attacking pieces.
+             * @param board The current state of the board.
+             * @param occupied The occupancy that blocks sliding pieces (may differ from the board's).
+             * @return A Bitboard of the attacking pieces' squares.
+             ****************************************************************************************************/
+            static Bitboard GetAttackersTo(int square, Enums::Color attacker_color, const Board &board, Bitboard occupied);
+
+            /***********************************************************************************************
+             * @brief Returns every square attacked by the pieces of a color, computed in one pass.
+             * Useful when many squares are tested against the same position (King moves, castling paths).
+             * @param attacker_color The color of the attacking pieces.
+             * @param board The current state of the board.
+             * @return A Bitboard of every attacked square.
+             **********************************************************************************************/
+            static Bitboard GetAttackedSquares(Enums::Color attacker_color, const Board &board);
+
+            /**************************************************************************************************
+             * @brief Returns every square attacked by the pieces of a color for a given occupancy.
+             * @param attacker_color The color of the attacking pieces.
+             * @param board The current state of the board.
+             * @param occupied The occupancy that blocks sliding pieces (e.g. with the defending King removed).
+             * @return A Bitboard of every attacked square.
+             *************************************************************************************************/
+            static Bitboard GetAttackedSquares(Enums::Color attacker_color, const Board &board, Bitboard occupied);
+
             /**************************************************************************
              * @brief Checks if the specified player's King is currently in check.
              * @param player_color The color of the player whose king is being checked.
@@ -69,11 +132,12 @@ namespace GameLogic
             static bool IsKingInCheck(Enums::Color player_color, const Board &board);
 
             /******************************************************************************************
-             * @brief Simulates a move to determine if the player's King would be safe afterward.
+             * @brief Determines if the player's King would be safe after a move.
              * Essential for validating potential moves that might expose the King to check (pins).
-             * @param move The move to simulate.
+             * The move is applied to a copy of the occupancy Bitboards only; the board is not modified.
+             * @param move The move to test.
              * @param player_color The color of the player making the move.
-             * @param board The current state of the board (will be temporarily modified and restored).
+             * @param board The current state of the board.
              * @return true if the King is safe after the move, false otherwise.
              *****************************************************************************************/
             static bool IsKingSafeAfterMove(const Move &move, Enums::Color player_color, Board &board);
@@ -113,6 +177,34 @@ namespace GameLogic
              * @return true if the moving piece is a Pawn, false otherwise.
              *************************************************************/
             static bool IsPawnMove(const Move &move, const Board &board);
+
+        private:
+            /*********************************************************************************************************
+             * @brief Generates the legal moves of the pieces standing on a set of squares.
+             *
+             * The checkers of the player's King and the player's pinned pieces are computed once. Every move is then
+             * masked so that it blocks or captures a single checker and stays on its pin line; only King moves,
+             * en passant and castling query attacks on the squares they touch. The en passant target and castling
+             * rights are read from the Board.
+             *
+             * @param player_color The color of the player making the moves.
+             * @param board The current state of the board.
+             * @param from_squares Only pieces on these squares generate moves.
+             * @param legal_moves The MoveList the legal moves are appended to.
+             ********************************************************************************************************/
+            static void GenerateLegalMoves(
+                Enums::Color player_color, const Board &board, Bitboard from_squares, MoveList &legal_moves);
+
+            /*********************************************************************************************
+             * @brief Appends the castling moves available to the player. The King must not be in check.
+             * @param player_color The color of the player castling.
+             * @param board The current state of the board.
+             * @param king_square The square (0-63) of the player's King.
+             * @param attacked_squares Every square attacked by the opponent.
+             * @param legal_moves The MoveList the legal castling moves are appended to.
+             ********************************************************************************************/
+            static void GenerateCastleMoves(
+                Enums::Color player_color, const Board &board, int king_square, Bitboard attacked_squares, MoveList &legal_moves);
     };
 } // namespace GameLogic
 
@@ -0,0 +1,216 @@
+#include "chess_app/engine_options.hpp"
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace ChessApp
+{
+    namespace
+    {
+        /** @brief The smallest and largest hash table sized from the machine, in MB. */
+        constexpr int MIN_HASH_MB = 16;
+        constexpr int MAX_HASH_MB = 16384;
+
+        /** @brief The share of the usable memory given to the hash table. */
+        constexpr std::uint64_t HASH_MEMORY_DIVISOR = 16;
+
+        int ParsePositiveInt(const std::string &value, const std::string &name, int line_number)
+        {
+            std::size_t parsed_length = 0;
+            int number = 0;
+
+            try
+            {
+                number = std::stoi(value, &parsed_length);
+            }
+            catch (const std::exception &)
+            {
+                parsed_length = 0;
+            }
+
+            if (parsed_length != value.size() || number <= 0)
+            {
+                throw std::invalid_argument("Engine config line " + std::to_string(line_number) + ": "
+                                            + name + " must be a positive integer, got '" + value + "'.");
+            }
+            return number;
+        }
+
+#if defined(__linux__)
+        // A cgroup limit file holds a number of bytes, or "max" when there is no limit
+        std::uint64_t ReadCgroupMemoryLimit(const char *path)
+        {
+            std::ifstream file(path);
+            std::string limit;
+            auto is_digit = [](unsigned char character) { return std::isdigit(character) != 0; };
+
+            if (!(file >> limit) || !std::all_of(limit.begin(), limit.end(), is_digit))
+            {
+                return 0;
+            }
+            return std::stoull(limit);
+        }
+#endif
+    } // namespace
+
+    EngineOptions EngineOptions::FromHardware()
+    {
+        EngineOptions options;
+
+        // Leave a core for the GUI so rendering stays smooth while the engine thinks
+        const unsigned int core_count = GetUsableCoreCount();
+        options.threads = static_cast<int>(std::max(1u, core_count - 1));
+
+        const std::uint64_t memory_mb = GetUsableMemoryBytes() / (1024 * 1024);
+        int hash_mb = MIN_HASH_MB;
+        while (hash_mb < MAX_HASH_MB && static_cast<std::uint64_t>(hash_mb) * 2 * HASH_MEMORY_DIVISOR <= memory_mb)
+        {
+            hash_mb *= 2;
+        }
+        options.hash_mb = hash_mb;
+
+        return options;
+    }
+
+    EngineOptions EngineOptions::FromFile(const std::string &path)
+    {
+        EngineOptions options = FromHardware();
+
+        std::ifstream file(path);
+        if (!file)
+        {
+            return options;
+        }
+
+        std::string line;
+        int line_number = 0;
+
+        while (std::getline(file, line))
+        {
+            line_number++;
+            boost::algorithm::trim(line);
+
+            if (line.empty() || line.front() == '#')
+            {
+                continue;
+            }
+
+            const std::size_t equals = line.find('=');
+            if (equals == std::string::npos)
+            {
+                throw std::invalid_argument("Engine config line " + std::to_string(line_number) + ": expected 'Name = value'.");
+            }
+
+            const std::string name = boost::algorithm::trim_copy(line.substr(0, equals));
+            const std::string value = boost::algorithm::trim_copy(line.substr(equals + 1));
+
+            if (boost::algorithm::iequals(name, "Threads"))
+            {
+                options.threads = ParsePositiveInt(value, name, line_number);
+            }
+            else if (boost::algorithm::iequals(name, "Hash"))
+            {
+                options.hash_mb = ParsePositiveInt(value, name, line_number);
+            }
+            else if (boost::algorithm::iequals(name, "MultiPV"))
+            {
+                options.multi_pv = ParsePositiveInt(value, name, line_number);
+            }
+            else if (boost::algorithm::iequals(name, "NumaPolicy"))
+            {
+                options.numa_policy = value;
+            }
+            else if (boost::algorithm::iequals(name, "Ponder"))
+            {
+                if (!boost::algorithm::iequals(value, "true") && !boost::algorithm::iequals(value, "false"))
+                {
+                    throw std::invalid_argument("Engine config line " + std::to_string(line_number) + ": "
+                                                + name + " must be true or false, got '" + value + "'.");
+                }
+                options.ponder = boost::algorithm::iequals(value, "true");
+            }
+            else
+            {
+                throw std::invalid_argument("Engine config line " + std::to_string(line_number) + ": unknown option '" + name + "'.");
+            }
+        }
+
+        return options;
+    }
+
+    unsigned int EngineOptions::GetUsableCoreCount()
+    {
+        unsigned int core_count = std::max(1u, std::thread::hardware_concurrency());
+
+#if defined(__linux__)
+        // The cores this process is pinned to, e.g. by taskset or a container's cpuset
+        cpu_set_t cpu_set;
+        if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0 && CPU_COUNT(&cpu_set) > 0)
+        {
+            core_count = std::min(core_count, static_cast<unsigned int>(CPU_COUNT(&cpu_set)));
+        }
+
+        // A cgroup v2 CPU quota, "<quota> <period>" in microseconds or "max <period>"
+        std::ifstream cpu_max("/sys/fs/cgroup/cpu.max");
+        std::string quota;
+        long long period = 0;
+        if (cpu_max >> quota >> period && quota != "max" && period > 0)
+        {
+            const long long quota_us = std::stoll(quota);
+            const unsigned int quota_cores = static_cast<unsigned int>(std::max(1LL, (quota_us + period - 1) / period));
+            core_count = std::min(core_count, quota_cores);
+        }
+#endif
+
+        return core_count;
+    }
+
+    std::uint64_t EngineOptions::GetUsableMemoryBytes()
+    {
+#if defined(_WIN32)
+        MEMORYSTATUSEX status;
+        status.dwLength = sizeof(status);
+        return GlobalMemoryStatusEx(&status) ? static_cast<std::uint64_t>(status.ullTotalPhys) : 0;
+#else
+        const long page_count = sysconf(_SC_PHYS_PAGES);
+        const long page_size = sysconf(_SC_PAGE_SIZE);
+        std::uint64_t memory = (page_count > 0 && page_size > 0)
+                             ? static_cast<std::uint64_t>(page_count) * static_cast<std::uint64_t>(page_size)
+                             : 0;
+
+#if defined(__linux__)
+        // A container's memory limit, cgroup v2 then v1 (where no limit reads as a huge number)
+        for (const char *path : {"/sys/fs/cgroup/memory.max", "/sys/fs/cgroup/memory/memory.limit_in_bytes"})
+        {
+            const std::uint64_t limit = ReadCgroupMemoryLimit(path);
+            if (limit > 0 && (memory == 0 || limit < memory))
+            {
+                memory = limit;
+            }
+        }
+#endif
+
+        return memory;
+#endif
+    }
+} // namespace ChessApp
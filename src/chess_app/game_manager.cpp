@@ -9,12 +9,17 @@
 #include "game_render/renderer/highlight_renderer.hpp"
 #include "game_render/constants.hpp"
 
+#include "chess_app/engine_options.hpp"
+#include "chess_app/search_limits.hpp"
 #include "chess_app/uci_handler.hpp"
 
 #include <SFML/Window.hpp>
 #include <SFML/Graphics.hpp>
 
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <string>
 #include <vector>
 #include <optional>
 #include <algorithm>
@@ -27,7 +32,7 @@ namespace ChessApp
         : game_(GameLogic::Game()),
         asset_manager_(),
         board_renderer_(&asset_manager_),
-        uci_handler_("./stockfish"),
+        uci_handler_("./stockfish", ChessApp::EngineOptions::FromFile("./engine.cfg")),
         window_(sf::VideoMode(
             {static_cast<unsigned int>(GameRender::Constants::INITIAL_WINDOW_WIDTH), static_cast<unsigned int>(GameRender::Constants::INITIAL_WINDOW_HEIGHT)}),
             "SFML_CHESS", sf::Style::Default),
@@ -47,6 +52,10 @@ namespace ChessApp
         ai_color_ = playing_as_black_
                     ? GameLogic::Enums::Color::Light
                     : GameLogic::Enums::Color::Dark;
+
+        // Depth 8, but never keep the player waiting more than 2 seconds
+        ai_search_limits_.depth = 8;
+        ai_search_limits_.movetime_ms = 2000;
     };
 
     void GameManager::Run()
@@ -117,6 +126,7 @@ namespace ChessApp
             {
                 if (game_.CanUndo())
                 {
+                    CancelAIMove();
                     game_.UnExecuteMove();
                     game_.UnExecuteMove();
                     ClearSelectionState();
@@ -127,6 +137,7 @@ namespace ChessApp
             {
                 if (game_.CanRedo())
                 {
+                    CancelAIMove();
                     game_.ReExecuteMove();
                     game_.ReExecuteMove();
                     ClearSelectionState();
@@ -136,14 +147,18 @@ namespace ChessApp
 
             else if (key_event->code == sf::Keyboard::Key::N && key_event->control)
             {
+                CancelAIMove();
                 game_.Reset();
+                uci_handler_.NewGame();
                 ClearSelectionState();
                 showing_game_over_dialog_ = false;
             }
 
             else if (key_event->code == sf::Keyboard::Key::T && key_event->control)
             {
+                CancelAIMove();
                 game_.Reset();
+                uci_handler_.NewGame();
                 ClearSelectionState();
                 showing_game_over_dialog_ = false;
                 HandleSwitchColor();
@@ -164,6 +179,12 @@ namespace ChessApp
 
     void GameManager::HandleClickOnBoardEvent(sf::Vector2f world_pos)
     {
+        // The board stays visible while the engine thinks, but its pieces are not ours to move
+        if (IsAITurn())
+        {
+            return;
+        }
+
         int col = static_cast<int>(world_pos.x / GameRender::Constants::SQUARE_SIZE);
         int row = static_cast<int>(world_pos.y / GameRender::Constants::SQUARE_SIZE);
 
@@ -316,7 +337,9 @@ namespace ChessApp
 
             if (IsPointInRect(world_pos, new_game_rect))
             {
+                CancelAIMove();
                 game_.Reset();
+                uci_handler_.NewGame();
                 ClearSelectionState();
                 showing_game_over_dialog_ = false;
                 return;
@@ -334,13 +357,10 @@ namespace ChessApp
         CheckGameOver();
     }
 
-    void GameManager::ExecuteAIMove()
+    void GameManager::ExecuteAIMove(const std::string &uci_best_move)
     {
-        std::string fen_str = this->game_.GenerateFen();
-        std::string uci_best_move = this->uci_handler_.GetBestMove(fen_str);
         auto [from_position, to_position, promotion_type] = GameLogic::Move::FromUCI(uci_best_move);
 
-        std::cout << fen_str << "\n";
         std::cout << uci_best_move << "\n";
 
         auto ai_legal_moves = this->game_.GetLegalMovesAtPosition(from_position);
@@ -375,12 +395,50 @@ namespace ChessApp
 
     void GameManager::TryExecuteAIMove()
     {
-        GameLogic::Enums::Color current_player = this->game_.GetCurrentPlayer().GetColor();
+        if (!IsAITurn() || this->game_.IsGameOver())
+        {
+            return;
+        }
+
+        // Start a search on the AI's turn, then check on it once per frame so rendering never waits for the engine
+        if (!this->ai_move_future_.valid())
+        {
+            this->ai_move_future_ = this->uci_handler_.StartSearch(this->game_, this->ai_search_limits_);
+            return;
+        }
+
+        if (this->ai_move_future_.wait_for(std::chrono::seconds::zero()) == std::future_status::ready)
+        {
+            const ChessApp::BestMove best_move = this->ai_move_future_.get();
+            ExecuteAIMove(best_move.move);
+
+            // Think on the expected reply while the player thinks, StartSearch picks it up if the guess was right
+            if (!this->game_.IsGameOver())
+            {
+                this->uci_handler_.StartPonder(this->game_, best_move.ponder_move, this->ai_search_limits_);
+            }
+        }
+    }
+
+    void GameManager::CancelAIMove()
+    {
+        // A ponder search is for a position that is about to change as well
+        this->uci_handler_.CancelPonder();
 
-        if (ai_color_ == current_player)
+        if (!this->ai_move_future_.valid())
         {
-            ExecuteAIMove();
+            return;
         }
+
+        // The engine answers stop at once, its move is for a position that is about to change
+        this->uci_handler_.Stop();
+        this->ai_move_future_.wait();
+        this->ai_move_future_ = std::future<ChessApp::BestMove>();
+    }
+
+    bool GameManager::IsAITurn() const
+    {
+        return this->ai_color_ == this->game_.GetCurrentPlayer().GetColor();
     }
 
     void GameManager::UpdateHighlight(GameLogic::Position selected_position, sf::Color highlight_color)
@@ -422,6 +480,8 @@ namespace ChessApp
     {
         if (game_.IsGameOver())
         {
+            // Nothing left to ponder on
+            uci_handler_.CancelPonder();
             showing_game_over_dialog_ = true;
         }
     }
@@ -0,0 +1,98 @@
+#include "chess_app/search_limits.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace ChessApp
+{
+    namespace
+    {
+        void AppendLimit(std::string &command, const char *name, const std::optional<int> &value)
+        {
+            if (!value.has_value())
+            {
+                return;
+            }
+            if (*value < 0)
+            {
+                throw std::invalid_argument(std::string("Search limit '") + name + "' can't be negative.");
+            }
+
+            command += ' ';
+            command += name;
+            command += ' ';
+            command += std::to_string(*value);
+        }
+    } // namespace
+
+    SearchLimits SearchLimits::Depth(int depth)
+    {
+        SearchLimits limits;
+        limits.depth = depth;
+        return limits;
+    }
+
+    SearchLimits SearchLimits::MoveTime(int movetime_ms)
+    {
+        SearchLimits limits;
+        limits.movetime_ms = movetime_ms;
+        return limits;
+    }
+
+    SearchLimits SearchLimits::Clock(int wtime_ms, int btime_ms, int winc_ms, int binc_ms)
+    {
+        SearchLimits limits;
+        limits.wtime_ms = wtime_ms;
+        limits.btime_ms = btime_ms;
+        limits.winc_ms = winc_ms;
+        limits.binc_ms = binc_ms;
+        return limits;
+    }
+
+    SearchLimits SearchLimits::Nodes(std::uint64_t nodes)
+    {
+        SearchLimits limits;
+        limits.nodes = nodes;
+        return limits;
+    }
+
+    SearchLimits SearchLimits::Infinite()
+    {
+        SearchLimits limits;
+        limits.infinite = true;
+        return limits;
+    }
+
+    std::string SearchLimits::ToGoCommand() const
+    {
+        if (this->depth.has_value() && *this->depth <= 0)
+        {
+            throw std::invalid_argument("Search limit 'depth' must be positive.");
+        }
+
+        std::string command = "go";
+
+        AppendLimit(command, "wtime", this->wtime_ms);
+        AppendLimit(command, "btime", this->btime_ms);
+        AppendLimit(command, "winc", this->winc_ms);
+        AppendLimit(command, "binc", this->binc_ms);
+        AppendLimit(command, "movestogo", this->moves_to_go);
+        AppendLimit(command, "depth", this->depth);
+
+        if (this->nodes.has_value())
+        {
+            command += " nodes " + std::to_string(*this->nodes);
+        }
+
+        AppendLimit(command, "movetime", this->movetime_ms);
+
+        if (this->infinite)
+        {
+            command += " infinite";
+        }
+
+        return command;
+    }
+} // namespace ChessApp
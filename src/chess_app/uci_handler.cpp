@@ -1,16 +1,56 @@
 #include "chess_app/uci_handler.hpp"
+#include "game_logic/game.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/fen.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/move_record.hpp"
+#include "game_logic/base/position_state.hpp"
+
+#include "chess_app/engine_options.hpp"
+#include "chess_app/search_limits.hpp"
 #include <boost/process.hpp>
 #include <boost/asio.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <chrono>
+#include <exception>
+#include <future>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
 
 
 namespace ChessApp
 {
-    UCIHandler::UCIHandler(const std::string &engine_path)
+    namespace
+    {
+        // Ex: "bestmove e2e4 ponder c7c5"
+        BestMove ParseBestMove(const std::string &move_line)
+        {
+            std::vector<std::string> parts;
+
+            boost::split(parts, move_line, boost::is_any_of(" "));
+
+            if (parts.size() <= 1)
+            {
+                throw std::runtime_error("Failed to parse 'bestmove' response.");
+            }
+
+            BestMove best_move{parts.at(1), std::string()};
+            if (parts.size() >= 4 && parts.at(2) == "ponder")
+            {
+                best_move.ponder_move = parts.at(3);
+            }
+            return best_move;
+        }
+    } // namespace
+
+    UCIHandler::UCIHandler(const std::string &engine_path, const EngineOptions &options)
+        : options_(options)
     {
         CreateAndConnectUCIProcess(engine_path);
     }
@@ -18,32 +58,217 @@ namespace ChessApp
     UCIHandler::~UCIHandler()
     {
         SendCommand("quit");
+
+        // The engine closes its output when it quits, which ends the I/O thread
+        if (this->io_thread_.joinable())
+        {
+            this->io_thread_.join();
+        }
+
         this->pipe_is_.close();
         this->pipe_os_.close();
         this->process_child_.wait();
     }
 
-    std::string UCIHandler::GetBestMove(const std::string fen, int depth, int search_time_ms)
+    std::string UCIHandler::GetBestMove(const std::string fen, const SearchLimits &limits)
+    {
+        return StartSearch(fen, limits).get().move;
+    }
+
+    std::future<BestMove> UCIHandler::StartSearch(const std::string &fen, const SearchLimits &limits)
     {
-        std::string fen_string_cmd = "position fen " + fen;
-        std::string depth_cmd = "go depth " + std::to_string(depth);
+        CancelPonder();
+        std::future<BestMove> best_move = SendSearch("position fen " + fen, limits);
 
-        SendCommand(fen_string_cmd);
-        SendCommand(depth_cmd);
+        // The engine's position no longer follows the cached game
+        this->position_start_.reset();
+        return best_move;
+    }
 
-        // Ex: "bestmove e2e4 ponder c7c5"
-        std::string move_line = WaitForResponse("bestmove");
+    std::future<BestMove> UCIHandler::StartSearch(const GameLogic::Game &game, const SearchLimits &limits)
+    {
+        if (IsPondering())
+        {
+            const std::vector<GameLogic::MoveRecord> &history = game.GetMoveHistory();
+
+            // The pondered position is the searched game plus the ponder move
+            const bool is_ponder_hit = FollowsPositionCommand(game)
+                && history.size() == this->position_moves_.size() + 1
+                && history.back().ReadMoveMade().ToUCI() == this->ponder_move_;
+
+            if (is_ponder_hit)
+            {
+                SendCommand("ponderhit");
+                this->ponder_move_.clear();
+                return std::move(this->ponder_future_);
+            }
+        }
+
+        CancelPonder();
+        UpdatePositionCommand(game);
+        return SendSearch(this->position_command_, limits);
+    }
+
+    bool UCIHandler::StartPonder(const GameLogic::Game &game, const std::string &ponder_move, const SearchLimits &limits)
+    {
+        if (!this->is_ponder_enabled_ || ponder_move.empty())
+        {
+            return false;
+        }
+
+        CancelPonder();
+        UpdatePositionCommand(game);
+        this->ponder_future_ = SendSearch(this->position_command_ + " " + ponder_move, limits, true);
+        this->ponder_move_ = ponder_move;
+        return true;
+    }
+
+    void UCIHandler::CancelPonder()
+    {
+        if (!this->ponder_future_.valid())
+        {
+            return;
+        }
+
+        // The engine answers stop at once, the move it found is for a position that won't be played
+        this->ponder_move_.clear();
+        Stop();
+        this->ponder_future_.wait();
+        this->ponder_future_ = std::future<BestMove>();
+    }
+
+    bool UCIHandler::IsPondering() const
+    {
+        return !this->ponder_move_.empty() && this->ponder_future_.valid()
+            && this->ponder_future_.wait_for(std::chrono::seconds::zero()) != std::future_status::ready;
+    }
+
+    void UCIHandler::NewGame()
+    {
+        CancelPonder();
+        if (IsSearching())
+        {
+            throw std::logic_error("Can't start a new game: a search is running.");
+        }
+
+        SendCommand("ucinewgame");
+        this->position_start_.reset();
+    }
+
+    void UCIHandler::UpdatePositionCommand(const GameLogic::Game &game)
+    {
+        const GameLogic::PositionState &start = game.GetStartPosition();
+        const std::vector<GameLogic::MoveRecord> &history = game.GetMoveHistory();
+
+        // An undo, a new game or a new start position: write the command from scratch
+        if (!FollowsPositionCommand(game))
+        {
+            this->position_start_ = start;
+            this->position_moves_.clear();
+
+            if (game.StartsFromStandardPosition())
+            {
+                this->position_command_ = "position startpos moves";
+            }
+            else
+            {
+                GameLogic::Board board;
+                board.LoadPositionState(start);
+
+                char fen[GameLogic::Fen::MAX_FEN_LENGTH];
+                GameLogic::Fen::WriteFen(board, GameLogic::Fen::FenClocks{start.GetHalfmoveClock(), start.GetFullmoveNumber()},
+                                         fen, sizeof(fen));
+                this->position_command_ = std::string("position fen ") + fen + " moves";
+            }
+        }
 
-        std::vector<std::string> parts;
+        // "moves" with nothing after it is valid UCI, the engine just plays no moves
+        for (std::size_t index = this->position_moves_.size(); index < history.size(); index++)
+        {
+            const GameLogic::Move &move = history[index].ReadMoveMade();
+            this->position_command_ += ' ';
+            this->position_command_ += move.ToUCI();
+            this->position_moves_.push_back(move);
+        }
+    }
 
-        boost::split(parts, move_line, boost::is_any_of(" "));
+    bool UCIHandler::FollowsPositionCommand(const GameLogic::Game &game) const
+    {
+        const GameLogic::PositionState &start = game.GetStartPosition();
+        const std::vector<GameLogic::MoveRecord> &history = game.GetMoveHistory();
 
-        if (parts.size() <= 1)
+        if (!this->position_start_.has_value()
+            || this->position_start_->GetZobristKey() != start.GetZobristKey()
+            || this->position_start_->GetHalfmoveClock() != start.GetHalfmoveClock()
+            || this->position_start_->GetFullmoveNumber() != start.GetFullmoveNumber()
+            || this->position_moves_.size() > history.size())
         {
-            throw std::runtime_error("Failed to parse 'bestmove' response.");
+            return false;
         }
 
-        return parts.at(1);
+        // Move::operator== ignores the promotion piece, which matters to the engine
+        for (std::size_t index = 0; index < this->position_moves_.size(); index++)
+        {
+            const GameLogic::Move &move = history[index].ReadMoveMade();
+            if (!(move == this->position_moves_[index])
+                || move.GetPromotionPieceType() != this->position_moves_[index].GetPromotionPieceType())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::future<BestMove> UCIHandler::SendSearch(const std::string &position_cmd, const SearchLimits &limits, bool is_ponder)
+    {
+        // Build the command first so invalid limits leave no search behind, "go ponder ..." searches like "go ..."
+        std::string go_cmd = limits.ToGoCommand();
+        if (is_ponder)
+        {
+            go_cmd.insert(2, " ponder");
+        }
+        std::future<BestMove> best_move;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+
+            if (!this->is_connected_)
+            {
+                throw std::runtime_error("Can't search: the engine is not running.");
+            }
+            if (this->search_promise_.has_value())
+            {
+                throw std::logic_error("Can't search: a search is already running.");
+            }
+
+            // Set before the go command so the I/O thread can't miss the answer
+            this->search_promise_.emplace();
+            best_move = this->search_promise_->get_future();
+        }
+
+        SendCommand(position_cmd);
+        SendCommand(go_cmd);
+
+        return best_move;
+    }
+
+    void UCIHandler::Stop()
+    {
+        // An engine that is not searching ignores stop, so a search ending meanwhile is harmless
+        if (IsSearching())
+        {
+            SendCommand("stop");
+        }
+    }
+
+    bool UCIHandler::IsSearching() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        return this->search_promise_.has_value();
+    }
+
+    const EngineOptions &UCIHandler::GetOptions() const
+    {
+        return this->options_;
     }
 
     void UCIHandler::CreateAndConnectUCIProcess(const std::string &engine_path)
@@ -56,12 +281,21 @@ namespace ChessApp
                 bp::std_out > this->pipe_is_ // (child's output) stdout TO  (Parent) ipstream
             );
 
-            if (!UseUCI() || !IsReady())
+            this->is_connected_ = true;
+            this->io_thread_ = std::thread(&UCIHandler::ReadEngineOutput, this);
+
+            if (!UseUCI())
             {
                 throw std::runtime_error("UCI command failed during initialization: Can't use 'usi' or 'isready'\n");
             }
 
-            SendCommand("setoption name Threads value 8");
+            // Options before isready, so the engine has allocated its hash table and threads once it answers
+            ApplyOptions();
+
+            if (!IsReady())
+            {
+                throw std::runtime_error("UCI command failed during initialization: Can't use 'usi' or 'isready'\n");
+            }
         }
         catch (const std::exception& e)
         {
@@ -69,17 +303,103 @@ namespace ChessApp
         }
     }
 
+    void UCIHandler::ApplyOptions()
+    {
+        SetOption("Threads", std::to_string(this->options_.threads));
+        SetOption("Hash", std::to_string(this->options_.hash_mb));
+        SetOption("MultiPV", std::to_string(this->options_.multi_pv));
+
+        // The engine manages its time differently when it may ponder
+        this->is_ponder_enabled_ = this->options_.ponder && SetOption("Ponder", "true");
+
+        if (!this->options_.numa_policy.empty())
+        {
+            SetOption("NumaPolicy", this->options_.numa_policy);
+        }
+    }
+
+    bool UCIHandler::SetOption(const std::string &name, const std::string &value)
+    {
+        // UCI option names are case insensitive
+        if (this->supported_options_.count(boost::algorithm::to_lower_copy(name)) == 0)
+        {
+            std::cerr << "Engine has no option '" << name << "', skipped." << std::endl;
+            return false;
+        }
+
+        SendCommand("setoption name " + name + " value " + value);
+        return true;
+    }
+
     void UCIHandler::SendCommand(const std::string &command)
     {
         this->pipe_os_ << command << std::endl;
     }
 
-    std::string UCIHandler::WaitForResponse(const std::string& expected_response_substring)
+    void UCIHandler::ReadEngineOutput()
     {
         std::string line;
 
         while (std::getline(this->pipe_is_, line))
         {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+
+            std::lock_guard<std::mutex> lock(this->mutex_);
+
+            if (line.rfind("bestmove", 0) == 0 && this->search_promise_.has_value())
+            {
+                try
+                {
+                    this->search_promise_->set_value(ParseBestMove(line));
+                }
+                catch (const std::runtime_error &)
+                {
+                    this->search_promise_->set_exception(std::current_exception());
+                }
+                this->search_promise_.reset();
+                continue;
+            }
+
+            // Search progress is not used, don't let it pile up
+            if (line.rfind("info", 0) == 0)
+            {
+                continue;
+            }
+
+            this->responses_.push_back(line);
+            this->response_cv_.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        this->is_connected_ = false;
+        if (this->search_promise_.has_value())
+        {
+            this->search_promise_->set_exception(std::make_exception_ptr(std::runtime_error("Fatal Error: The engine exited during a search")));
+            this->search_promise_.reset();
+        }
+        this->response_cv_.notify_all();
+    }
+
+    std::string UCIHandler::WaitForResponse(const std::string& expected_response_substring)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+
+        while (true)
+        {
+            this->response_cv_.wait(lock, [this]() { return !this->responses_.empty() || !this->is_connected_; });
+
+            if (this->responses_.empty())
+            {
+                break;
+            }
+
+            std::string line = std::move(this->responses_.front());
+            this->responses_.pop_front();
+
             if (line.find(expected_response_substring) != std::string::npos)
             {
                 return line;
@@ -90,11 +410,27 @@ namespace ChessApp
         throw std::runtime_error("Fatal Error: Expected Reposnse Not Found");
     }
 
-
     bool UCIHandler::UseUCI()
     {
         SendCommand("uci");
-        return WaitForResponse("uciok") == std::string{"uciok"};
+
+        // Ex: "option name Threads type spin default 1 min 1 max 1024", listed before "uciok"
+        const std::string option_prefix = "option name ";
+        while (true)
+        {
+            std::string line = WaitForResponse("");
+
+            if (line == "uciok")
+            {
+                return true;
+            }
+            if (line.rfind(option_prefix, 0) == 0)
+            {
+                const std::size_t type_start = line.find(" type ", option_prefix.size());
+                const std::string name = line.substr(option_prefix.size(), type_start - option_prefix.size());
+                this->supported_options_.insert(boost::algorithm::to_lower_copy(name));
+            }
+        }
     }
 
     bool UCIHandler::IsReady()
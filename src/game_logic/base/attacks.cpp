@@ -0,0 +1,312 @@
+#include "game_logic/base/attacks.hpp"
+#include "game_logic/base/bitboard.hpp"
+
+#include "game_logic/enums.hpp"
+#include "game_logic/constants.hpp"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace GameLogic
+{
+    namespace Attacks
+    {
+        namespace
+        {
+            // The total number of entries needed by every rook and bishop square (fancy magic layout)
+            constexpr int ROOK_TABLE_SIZE = 0x19000;
+            constexpr int BISHOP_TABLE_SIZE = 0x1480;
+
+            // The lookup data for one sliding piece on one square
+            struct Magic
+            {
+                Bitboard mask;       // Relevant occupancy (ray squares excluding the board edge)
+                Bitboard magic;      // Multiplier mapping an occupancy subset onto a unique index
+                const Bitboard *attacks; // This square's slice of the shared attack table
+                unsigned shift;      // 64 - number of relevant bits
+
+                unsigned Index(Bitboard occupied) const
+                {
+#if defined(__BMI2__)
+                    return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+                    return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+                }
+            };
+
+            struct Direction
+            {
+                int row_delta;
+                int col_delta;
+            };
+
+            constexpr std::array<Direction, 4> BishopDirs = {{{-1, -1}, {-1, 1}, {1, -1}, {1, 1}}};
+            constexpr std::array<Direction, 4> RookDirs = {{{-1, 0}, {1, 0}, {0, -1}, {0, 1}}};
+
+            bool IsOnBoard(int row, int col)
+            {
+                return row >= 0 && row < Constants::BOARD_SIZE && col >= 0 && col < Constants::BOARD_SIZE;
+            }
+
+            // Squares reached by single steps (knight, king, pawn)
+            Bitboard StepAttacks(int square, const Direction *directions, int direction_count)
+            {
+                const int row = square / Constants::BOARD_SIZE;
+                const int col = square % Constants::BOARD_SIZE;
+                Bitboard attacks = Bitboards::EMPTY;
+
+                for (int i = 0; i < direction_count; i++)
+                {
+                    const int to_row = row + directions[i].row_delta;
+                    const int to_col = col + directions[i].col_delta;
+                    if (IsOnBoard(to_row, to_col))
+                    {
+                        attacks |= Bitboards::SquareBB(Bitboards::ToSquare(to_row, to_col));
+                    }
+                }
+                return attacks;
+            }
+
+            // Squares reached by walking each ray until the first occupied square (slow, used for table building)
+            Bitboard RayAttacks(int square, Bitboard occupied, const std::array<Direction, 4> &directions)
+            {
+                const int row = square / Constants::BOARD_SIZE;
+                const int col = square % Constants::BOARD_SIZE;
+                Bitboard attacks = Bitboards::EMPTY;
+
+                for (const Direction &direction : directions)
+                {
+                    int to_row = row + direction.row_delta;
+                    int to_col = col + direction.col_delta;
+
+                    while (IsOnBoard(to_row, to_col))
+                    {
+                        const Bitboard to_bb = Bitboards::SquareBB(Bitboards::ToSquare(to_row, to_col));
+                        attacks |= to_bb;
+                        if (occupied & to_bb)
+                        {
+                            break;
+                        }
+                        to_row += direction.row_delta;
+                        to_col += direction.col_delta;
+                    }
+                }
+                return attacks;
+            }
+
+            // Magic numbers for every square, found offline with a sparse random search over the square
+            // layout used by Bitboards (a8 = 0). Each one maps every relevant occupancy of its square onto
+            // a table slot without destructive collisions.
+            constexpr std::array<Bitboard, Bitboards::SQUARE_COUNT> BishopMagicNumbers =
+            {
+                0x40106000A1160020ULL, 0x0020010250810120ULL, 0x2010010220280081ULL, 0x002806004050C040ULL,
+                0x0002021018000000ULL, 0x2001112010000400ULL, 0x0881010120218080ULL, 0x1030820110010500ULL,
+                0x0000120222042400ULL, 0x2000020404040044ULL, 0x8000480094208000ULL, 0x0003422A02000001ULL,
+                0x000A220210100040ULL, 0x8004820202226000ULL, 0x0018234854100800ULL, 0x0100004042101040ULL,
+                0x0004001004082820ULL, 0x0010000810010048ULL, 0x1014004208081300ULL, 0x2080818802044202ULL,
+                0x0040880C00A00100ULL, 0x0080400200522010ULL, 0x0001000188180B04ULL, 0x0080249202020204ULL,
+                0x1004400004100410ULL, 0x00013100A0022206ULL, 0x2148500001040080ULL, 0x4241080011004300ULL,
+                0x4020848004002000ULL, 0x10101380D1004100ULL, 0x0008004422020284ULL, 0x01010A1041008080ULL,
+                0x0808080400082121ULL, 0x0808080400082121ULL, 0x0091128200100C00ULL, 0x0202200802010104ULL,
+                0x8C0A020200440085ULL, 0x01A0008080B10040ULL, 0x0889520080122800ULL, 0x100902022202010AULL,
+                0x04081A0816002000ULL, 0x0000681208005000ULL, 0x8170840041008802ULL, 0x0A00004200810805ULL,
+                0x0830404408210100ULL, 0x2602208106006102ULL, 0x1048300680802628ULL, 0x2602208106006102ULL,
+                0x0602010120110040ULL, 0x0941010801043000ULL, 0x000040440A210428ULL, 0x0008240020880021ULL,
+                0x0400002012048200ULL, 0x00AC102001210220ULL, 0x0220021002009900ULL, 0x84440C080A013080ULL,
+                0x0001008044200440ULL, 0x0004C04410841000ULL, 0x2000500104011130ULL, 0x1A0C010011C20229ULL,
+                0x0044800112202200ULL, 0x0434804908100424ULL, 0x0300404822C08200ULL, 0x48081010008A2A80ULL
+            };
+
+            constexpr std::array<Bitboard, Bitboards::SQUARE_COUNT> RookMagicNumbers =
+            {
+                0x0A80004000801220ULL, 0x8040004010002008ULL, 0x2080200010008008ULL, 0x1100100008210004ULL,
+                0xC200209084020008ULL, 0x2100010004000208ULL, 0x0400081000822421ULL, 0x0200010422048844ULL,
+                0x0800800080400024ULL, 0x0001402000401000ULL, 0x3000801000802001ULL, 0x4400800800100083ULL,
+                0x0904802402480080ULL, 0x4040800400020080ULL, 0x0018808042000100ULL, 0x4040800080004100ULL,
+                0x0040048001458024ULL, 0x00A0004000205000ULL, 0x3100808010002000ULL, 0x4825010010000820ULL,
+                0x5004808008000401ULL, 0x2024818004000A00ULL, 0x0005808002000100ULL, 0x2100060004806104ULL,
+                0x0080400880008421ULL, 0x4062220600410280ULL, 0x010A004A00108022ULL, 0x0000100080080080ULL,
+                0x0021000500080010ULL, 0x0044000202001008ULL, 0x0000100400080102ULL, 0xC020128200040545ULL,
+                0x0080002000400040ULL, 0x0000804000802004ULL, 0x0000120022004080ULL, 0x010A386103001001ULL,
+                0x9010080080800400ULL, 0x8440020080800400ULL, 0x0004228824001001ULL, 0x000000490A000084ULL,
+                0x0080002000504000ULL, 0x200020005000C000ULL, 0x0012088020420010ULL, 0x0010010080080800ULL,
+                0x0085001008010004ULL, 0x0002000204008080ULL, 0x0040413002040008ULL, 0x0000304081020004ULL,
+                0x0080204000800080ULL, 0x3008804000290100ULL, 0x1010100080200080ULL, 0x2008100208028080ULL,
+                0x5000850800910100ULL, 0x8402019004680200ULL, 0x0120911028020400ULL, 0x0000008044010200ULL,
+                0x0020850200244012ULL, 0x0020850200244012ULL, 0x0000102001040841ULL, 0x140900040A100021ULL,
+                0x000200282410A102ULL, 0x000200282410A102ULL, 0x000200282410A102ULL, 0x4048240043802106ULL
+            };
+
+            // Fill the magics and attack table for one sliding piece type
+            void InitMagics(
+                const std::array<Direction, 4> &directions, const std::array<Bitboard, Bitboards::SQUARE_COUNT> &magic_numbers,
+                Bitboard *table, std::array<Magic, Bitboards::SQUARE_COUNT> &magics)
+            {
+                int table_offset = 0;
+
+                for (int square = 0; square < Bitboards::SQUARE_COUNT; square++)
+                {
+                    const int row = square / Constants::BOARD_SIZE;
+                    const int col = square % Constants::BOARD_SIZE;
+
+                    // Squares on the board edge never block anything beyond them, so they are not relevant
+                    const Bitboard row_edges = (Bitboards::RANK_8 | Bitboards::RANK_1) & ~(Bitboards::RANK_8 << (row * Constants::BOARD_SIZE));
+                    const Bitboard col_edges = (Bitboards::FILE_A | Bitboards::FILE_H) & ~(Bitboards::FILE_A << col);
+
+                    Magic &magic = magics[square];
+                    magic.mask = RayAttacks(square, Bitboards::EMPTY, directions) & ~(row_edges | col_edges);
+                    magic.magic = magic_numbers[square];
+                    magic.shift = 64 - Bitboards::PopCount(magic.mask);
+
+                    Bitboard *square_table = table + table_offset;
+                    magic.attacks = square_table;
+                    table_offset += 1 << Bitboards::PopCount(magic.mask);
+
+                    // Enumerate every subset of the mask (Carry-Rippler) and store its attacks
+                    Bitboard subset = Bitboards::EMPTY;
+                    do
+                    {
+                        square_table[magic.Index(subset)] = RayAttacks(square, subset, directions);
+                        subset = (subset - magic.mask) & magic.mask;
+                    } while (subset);
+                }
+            }
+
+            struct AttackTables
+            {
+                std::array<std::array<Bitboard, Bitboards::SQUARE_COUNT>, 2> pawn;
+                std::array<Bitboard, Bitboards::SQUARE_COUNT> knight;
+                std::array<Bitboard, Bitboards::SQUARE_COUNT> king;
+
+                std::array<Magic, Bitboards::SQUARE_COUNT> bishop_magics;
+                std::array<Magic, Bitboards::SQUARE_COUNT> rook_magics;
+                std::vector<Bitboard> bishop_table;
+                std::vector<Bitboard> rook_table;
+
+                std::array<std::array<Bitboard, Bitboards::SQUARE_COUNT>, Bitboards::SQUARE_COUNT> between;
+                std::array<std::array<Bitboard, Bitboards::SQUARE_COUNT>, Bitboards::SQUARE_COUNT> line;
+
+                AttackTables()
+                    : bishop_table(BISHOP_TABLE_SIZE), rook_table(ROOK_TABLE_SIZE)
+                {
+                    static constexpr Direction KnightDirs[] =
+                    {
+                        {-2, -1}, {-2, 1}, {2, -1}, {2, 1}, {-1, -2}, {1, -2}, {-1, 2}, {1, 2}
+                    };
+                    static constexpr Direction KingDirs[] =
+                    {
+                        {-1, 0}, {1, 0}, {0, 1}, {0, -1}, {-1, 1}, {-1, -1}, {1, 1}, {1, -1}
+                    };
+                    static constexpr Direction LightPawnDirs[] = {{-1, -1}, {-1, 1}};
+                    static constexpr Direction DarkPawnDirs[] = {{1, -1}, {1, 1}};
+
+                    for (int square = 0; square < Bitboards::SQUARE_COUNT; square++)
+                    {
+                        knight[square] = StepAttacks(square, KnightDirs, 8);
+                        king[square] = StepAttacks(square, KingDirs, 8);
+                        pawn[Bitboards::ColorIndex(Enums::Color::Light)][square] = StepAttacks(square, LightPawnDirs, 2);
+                        pawn[Bitboards::ColorIndex(Enums::Color::Dark)][square] = StepAttacks(square, DarkPawnDirs, 2);
+                    }
+
+                    InitMagics(BishopDirs, BishopMagicNumbers, bishop_table.data(), bishop_magics);
+                    InitMagics(RookDirs, RookMagicNumbers, rook_table.data(), rook_magics);
+
+                    for (int from_square = 0; from_square < Bitboards::SQUARE_COUNT; from_square++)
+                    {
+                        for (int to_square = 0; to_square < Bitboards::SQUARE_COUNT; to_square++)
+                        {
+                            between[from_square][to_square] = Bitboards::EMPTY;
+                            line[from_square][to_square] = Bitboards::EMPTY;
+
+                            const Bitboard ends = Bitboards::SquareBB(from_square) | Bitboards::SquareBB(to_square);
+
+                            for (const std::array<Direction, 4> *directions : {&BishopDirs, &RookDirs})
+                            {
+                                if (from_square != to_square && (RayAttacks(from_square, Bitboards::EMPTY, *directions) & Bitboards::SquareBB(to_square)))
+                                {
+                                    line[from_square][to_square] = (RayAttacks(from_square, Bitboards::EMPTY, *directions)
+                                                                 & RayAttacks(to_square, Bitboards::EMPTY, *directions)) | ends;
+                                    between[from_square][to_square] = RayAttacks(from_square, Bitboards::SquareBB(to_square), *directions)
+                                                                    & RayAttacks(to_square, Bitboards::SquareBB(from_square), *directions);
+                                }
+                            }
+                        }
+                    }
+                }
+            };
+
+            const AttackTables &Tables()
+            {
+                static const AttackTables tables;
+                return tables;
+            }
+        } // namespace
+
+        Bitboard PawnAttacks(Enums::Color color, int square)
+        {
+            return Tables().pawn[Bitboards::ColorIndex(color)][square];
+        }
+
+        Bitboard KnightAttacks(int square)
+        {
+            return Tables().knight[square];
+        }
+
+        Bitboard KingAttacks(int square)
+        {
+            return Tables().king[square];
+        }
+
+        Bitboard BishopAttacks(int square, Bitboard occupied)
+        {
+            const Magic &magic = Tables().bishop_magics[square];
+            return magic.attacks[magic.Index(occupied)];
+        }
+
+        Bitboard RookAttacks(int square, Bitboard occupied)
+        {
+            const Magic &magic = Tables().rook_magics[square];
+            return magic.attacks[magic.Index(occupied)];
+        }
+
+        Bitboard QueenAttacks(int square, Bitboard occupied)
+        {
+            return BishopAttacks(square, occupied) | RookAttacks(square, occupied);
+        }
+
+        Bitboard Between(int from_square, int to_square)
+        {
+            return Tables().between[from_square][to_square];
+        }
+
+        Bitboard Line(int from_square, int to_square)
+        {
+            return Tables().line[from_square][to_square];
+        }
+
+        Bitboard PieceAttacks(Enums::PieceType piece_type, int square, Bitboard occupied)
+        {
+            switch (piece_type)
+            {
+                case Enums::PieceType::Knight:
+                    return KnightAttacks(square);
+                case Enums::PieceType::Bishop:
+                    return BishopAttacks(square, occupied);
+                case Enums::PieceType::Rook:
+                    return RookAttacks(square, occupied);
+                case Enums::PieceType::Queen:
+                    return QueenAttacks(square, occupied);
+                case Enums::PieceType::King:
+                    return KingAttacks(square);
+                default:
+                    return Bitboards::EMPTY;
+            }
+        }
+    } // namespace Attacks
+} // namespace GameLogic
@@ -2,7 +2,11 @@
 #include "game_logic/base/move.hpp"
 #include "game_logic/base/move_record.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/position_state.hpp"
 #include "game_logic/base/piece.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
+#include "game_logic/base/zobrist.hpp"
 
 #include "game_logic/pieces/pawn.hpp"
 #include "game_logic/pieces/knight.hpp"
@@ -14,92 +18,172 @@
 #include "game_logic/enums.hpp"
 #include "game_logic/constants.hpp"
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
 #include <iostream>
+#include <stdexcept>
 
 namespace GameLogic
 {
+    namespace
+    {
+        // A piece keeps HasMoved == false only where that still matters: pawns on their start row,
+        // and kings and rooks on a start square whose castling right is still held
+        bool DeriveHasMoved(Enums::Color color, Enums::PieceType piece_type, int square, int castling_rights)
+        {
+            const bool is_light = color == Enums::Color::Light;
+            const int color_rights = is_light
+                                   ? (Constants::CASTLE_LIGHT_KS | Constants::CASTLE_LIGHT_QS)
+                                   : (Constants::CASTLE_DARK_KS | Constants::CASTLE_DARK_QS);
+
+            switch (piece_type)
+            {
+                case (Enums::PieceType::Pawn):
+                    return square / Constants::BOARD_SIZE != (is_light ? Constants::BOARD_SIZE - 2 : 1);
+                case (Enums::PieceType::King):
+                case (Enums::PieceType::Rook):
+                    return (castling_rights & color_rights & ~Bitboards::CastlingRightsKeptAfter(square)) == 0;
+                default:
+                    return true;
+            }
+        }
+
+        // Create a new Piece object of the given color and type
+        std::unique_ptr<Piece> CreatePiece(Enums::Color color, Enums::PieceType piece_type)
+        {
+            switch (piece_type)
+            {
+                case (Enums::PieceType::Pawn):
+                    return std::make_unique<Pawn>(color);
+                case (Enums::PieceType::Knight):
+                    return std::make_unique<Knight>(color);
+                case (Enums::PieceType::Bishop):
+                    return std::make_unique<Bishop>(color);
+                case (Enums::PieceType::Rook):
+                    return std::make_unique<Rook>(color);
+                case (Enums::PieceType::King):
+                    return std::make_unique<King>(color);
+                default:
+                    return std::make_unique<Queen>(color);
+            }
+        }
+
+        // Write the piece a move is about to capture into the record (nullptr for no capture)
+        void RecordCapturedPiece(MoveRecord &record, const Piece *captured_piece)
+        {
+            if (captured_piece == nullptr)
+            {
+                record.SetCapturedPiece(Bitboards::NO_PIECE, false);
+                return;
+            }
+            record.SetCapturedPiece(Bitboards::PieceIndex(captured_piece->GetColor(), captured_piece->GetPieceType()), captured_piece->HasMoved());
+        }
+    } // namespace
+
     // Construct the Board object, initialize the 8x8 board with nullptr
     Board::Board()
+        : piece_bitboards_{}, color_bitboards_{},
+        piece_counts_{},
+        king_squares_{Bitboards::NO_SQUARE, Bitboards::NO_SQUARE},
+        material_signature_(0),
+        side_to_move_(Enums::Color::Light),
+        castling_rights_(Constants::CASTLE_ALL),
+        en_passant_square_(Bitboards::NO_SQUARE),
+        zobrist_key_(0)
     {
+        // A side never has more than 10 pieces of one type (2 + 8 promotions)
+        for (std::vector<std::unique_ptr<Piece>> &spare_pieces : this->spare_pieces_)
+        {
+            spare_pieces.reserve(Constants::BOARD_SIZE + 2);
+        }
+
         InitializeBoard(); // Initialize the Pieces objects
     }
 
     void Board::InitializeBoard()
     {
-        this->board_.resize(8);  // 8 rows
-        for (auto& row : this->board_)
-        {
-            row.resize(8);  // 8 columns, each element initialized to nullptr
-        }
-
         // Place Dark pieces
-        PlacePieceAt(std::make_unique<Rook>(Enums::Color::Dark), Position(0, 0));
-        PlacePieceAt(std::make_unique<Knight>(Enums::Color::Dark), Position(0, 1));
-        PlacePieceAt(std::make_unique<Bishop>(Enums::Color::Dark), Position(0, 2));
-        PlacePieceAt(std::make_unique<Queen>(Enums::Color::Dark), Position(0, 3));
-        PlacePieceAt(std::make_unique<King>(Enums::Color::Dark), Position(0, 4));
-        PlacePieceAt(std::make_unique<Bishop>(Enums::Color::Dark), Position(0, 5));
-        PlacePieceAt(std::make_unique<Knight>(Enums::Color::Dark), Position(0, 6));
-        PlacePieceAt(std::make_unique<Rook>(Enums::Color::Dark), Position(0, 7));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Rook), Position(0, 0));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Knight), Position(0, 1));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Bishop), Position(0, 2));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Queen), Position(0, 3));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::King), Position(0, 4));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Bishop), Position(0, 5));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Knight), Position(0, 6));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Rook), Position(0, 7));
 
         // Place Light pieces
-        PlacePieceAt(std::make_unique<Rook>(Enums::Color::Light), Position(7, 0));
-        PlacePieceAt(std::make_unique<Knight>(Enums::Color::Light), Position(7, 1));
-        PlacePieceAt(std::make_unique<Bishop>(Enums::Color::Light), Position(7, 2));
-        PlacePieceAt(std::make_unique<Queen>(Enums::Color::Light), Position(7, 3));
-        PlacePieceAt(std::make_unique<King>(Enums::Color::Light), Position(7, 4));
-        PlacePieceAt(std::make_unique<Bishop>(Enums::Color::Light), Position(7, 5));
-        PlacePieceAt(std::make_unique<Knight>(Enums::Color::Light), Position(7, 6));
-        PlacePieceAt(std::make_unique<Rook>(Enums::Color::Light), Position(7, 7));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Rook), Position(7, 0));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Knight), Position(7, 1));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Bishop), Position(7, 2));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Queen), Position(7, 3));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::King), Position(7, 4));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Bishop), Position(7, 5));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Knight), Position(7, 6));
+        PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Rook), Position(7, 7));
 
         // Place Dark and Light pawns
         for (int col = 0; col < 8; col++)
         {
-            PlacePieceAt(std::make_unique<Pawn>(Enums::Color::Dark), Position(1, col));
-            PlacePieceAt(std::make_unique<Pawn>(Enums::Color::Light), Position(6, col));
+            PlacePieceAt(TakeSparePiece(Enums::Color::Dark, Enums::PieceType::Pawn), Position(1, col));
+            PlacePieceAt(TakeSparePiece(Enums::Color::Light, Enums::PieceType::Pawn), Position(6, col));
         }
+
+        SetPositionState(Enums::Color::Light, Constants::CASTLE_ALL, Bitboards::NO_SQUARE);
     }
 
+    // The pieces go through the spare pool, so resetting a Board that was already set up does not allocate
     void Board::ResetBoard()
     {
-        for (int row = 0; row < Constants::BOARD_SIZE; row++)
-        {
-            for (int col = 0; col < Constants::BOARD_SIZE; col++)
-            {
-                RemovePieceAt(Position{row, col});
-            }
-        }
-
+        StoreAllPieces();
         InitializeBoard();
     }
 
     // Make a Normal move for a Piece object from one position to another on the board
     MoveRecord Board::MakeMove(const Move& move)
     {
+        const int prev_castling_rights = this->castling_rights_;
+        const int prev_en_passant_square = this->en_passant_square_;
+        const ZobristKey prev_zobrist_key = this->zobrist_key_;
+
+        // Take out the en passant key while the pawns that could capture are still in place
+        this->zobrist_key_ ^= GetEnPassantZobristKey();
+
+        MoveRecord record;
+
         switch(move.GetMoveType())
         {
             case Enums::MoveType::Normal:
             case Enums::MoveType::DoublePawn:
-                return MakeNormalMove(move);
+                record = MakeNormalMove(move);
+                break;
 
             case Enums::MoveType::EnPassant:
-                return MakeEnPassantMove(move);
+                record = MakeEnPassantMove(move);
+                break;
 
             case Enums::MoveType::PawnPromotion:
-                return MakePawnPromotionMove(move);
+                record = MakePawnPromotionMove(move);
+                break;
 
             case Enums::MoveType::CastleKS:
             case Enums::MoveType::CastleQS:
-                return MakeCastleMove(move);
+                record = MakeCastleMove(move);
+                break;
+
             default:
                 throw std::runtime_error("Unknown or invalid MoveType provided to MakeMove.");
         }
+
+        record.SetPrevBoardState(prev_castling_rights, prev_en_passant_square, prev_zobrist_key);
+        UpdatePositionState(move);
+
+        return record;
     }
 
-    void Board::UnmakeMove(MoveRecord& record)
+    void Board::UnmakeMove(const MoveRecord& record)
     {
         switch(record.ReadMoveMade().GetMoveType())
         {
@@ -124,94 +208,145 @@ namespace GameLogic
             default:
                 throw std::runtime_error("Unknown or invalid MoveType found in Move Record during Unmake.");
         }
+
+        // Restore the state the pieces do not show, the saved key also undoes the piece updates above
+        this->side_to_move_ = (this->side_to_move_ == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+        this->castling_rights_ = record.ReadPrevCastlingRights();
+        this->en_passant_square_ = record.ReadPrevEnPassantSquare();
+        this->zobrist_key_ = record.ReadPrevZobristKey();
+    }
+
+    void Board::UpdatePositionState(const Move &move)
+    {
+        const int from_square = move.GetFromSquare();
+        const int to_square = move.GetToSquare();
+
+        const int castling_rights = this->castling_rights_ & Bitboards::CastlingRightsKeptAfter(from_square) & Bitboards::CastlingRightsKeptAfter(to_square);
+        this->zobrist_key_ ^= Zobrist::CastlingKey(this->castling_rights_) ^ Zobrist::CastlingKey(castling_rights);
+        this->castling_rights_ = castling_rights;
+
+        this->en_passant_square_ = (move.GetMoveType() == Enums::MoveType::DoublePawn)
+                                 ? (from_square + to_square) / 2
+                                 : Bitboards::NO_SQUARE;
+
+        this->side_to_move_ = (this->side_to_move_ == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+        this->zobrist_key_ ^= Zobrist::SideKey();
+
+        this->zobrist_key_ ^= GetEnPassantZobristKey();
+    }
+
+    // Only hash the en passant target if a pawn of the side to move stands ready to capture on it
+    ZobristKey Board::GetEnPassantZobristKey() const
+    {
+        if (this->en_passant_square_ == Bitboards::NO_SQUARE)
+        {
+            return 0;
+        }
+
+        const Enums::Color opponent_color = (this->side_to_move_ == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+        const Bitboard capturers = Attacks::PawnAttacks(opponent_color, this->en_passant_square_)
+                                 & GetPieceBitboard(this->side_to_move_, Enums::PieceType::Pawn);
+
+        return capturers ? Zobrist::EnPassantKey(this->en_passant_square_ % Constants::BOARD_SIZE) : 0;
+    }
+
+    ZobristKey Board::ComputeZobristKey() const
+    {
+        ZobristKey zobrist_key = 0;
+
+        Bitboard occupied = GetOccupiedBitboard();
+        while (occupied)
+        {
+            const int square = Bitboards::PopLowestSquare(occupied);
+            const Piece *piece = this->board_[square].get();
+            zobrist_key ^= Zobrist::PieceKey(piece->GetColor(), piece->GetPieceType(), square);
+        }
+
+        zobrist_key ^= Zobrist::CastlingKey(this->castling_rights_);
+        zobrist_key ^= GetEnPassantZobristKey();
+
+        if (this->side_to_move_ == Enums::Color::Dark)
+        {
+            zobrist_key ^= Zobrist::SideKey();
+        }
+
+        return zobrist_key;
     }
 
     MoveRecord Board::MakeNormalMove(const Move& move)
     {
-        const Position &from_position = move.GetFromPosition();
-        const Position &to_position = move.GetToPosition();
+        const Position from_position = move.GetFromPosition();
+        const Position to_position = move.GetToPosition();
 
         MoveRecord record;
         record.SetMoveMade(move);
 
         std::unique_ptr<Piece> moving_piece = RemovePieceAt(from_position);
-        record.SetMovedPiece(moving_piece->ClonePiece());
+        record.SetMovedPieceHasMoved(moving_piece->HasMoved());
         moving_piece->SetHasMoved(true);
 
-        std::unique_ptr<Piece> captured_piece = RemovePieceAt(to_position);
-        record.SetCapturedPiece(std::move(captured_piece));
+        RecordCapturedPiece(record, GetPieceAt(to_position));
+        StoreSparePiece(RemovePieceAt(to_position));
 
         PlacePieceAt(std::move(moving_piece), to_position);
 
-        return std::move(record);
+        return record;
     }
 
     MoveRecord Board::MakeEnPassantMove(const Move& move)
     {
-        const Position &from_position = move.GetFromPosition();
-        const Position &to_position = move.GetToPosition();
+        const Position from_position = move.GetFromPosition();
+        const Position to_position = move.GetToPosition();
         const Position capture_position(from_position.GetRow(), to_position.GetCol());
 
         MoveRecord record;
         record.SetMoveMade(move);
 
         std::unique_ptr<Piece> moving_piece = RemovePieceAt(from_position);
-        record.SetMovedPiece(moving_piece->ClonePiece());
+        record.SetMovedPieceHasMoved(moving_piece->HasMoved());
         moving_piece->SetHasMoved(true);
 
-        std::unique_ptr<Piece> captured_piece = RemovePieceAt(capture_position);
-        record.SetCapturedPiece(std::move(captured_piece));
+        RecordCapturedPiece(record, GetPieceAt(capture_position));
+        StoreSparePiece(RemovePieceAt(capture_position));
 
         PlacePieceAt(std::move(moving_piece), to_position);
 
-        return std::move(record);
+        return record;
     }
 
     MoveRecord Board::MakePawnPromotionMove(const Move &move)
     {
-        const Position &from_position = move.GetFromPosition();
-        const Position &to_position = move.GetToPosition();
+        const Position from_position = move.GetFromPosition();
+        const Position to_position = move.GetToPosition();
         Enums::PieceType promoted_piece_type = move.GetPromotionPieceType();
 
         MoveRecord record;
         record.SetMoveMade(move);
 
         std::unique_ptr<Piece> moving_piece = RemovePieceAt(from_position);
-        record.SetMovedPiece(moving_piece->ClonePiece());
-
-        std::unique_ptr<Piece> captured_piece = RemovePieceAt(to_position);
-        record.SetCapturedPiece(std::move(captured_piece));
+        record.SetMovedPieceHasMoved(moving_piece->HasMoved());
 
-        std::unique_ptr<Piece> promoted_piece;
+        RecordCapturedPiece(record, GetPieceAt(to_position));
+        StoreSparePiece(RemovePieceAt(to_position));
 
-        switch (promoted_piece_type)
+        // No promotion piece chosen yet means a queen
+        if (promoted_piece_type == Enums::PieceType::None)
         {
-            case (Enums::PieceType::Bishop):
-                promoted_piece = std::make_unique<Bishop>(moving_piece->GetColor());
-                break;
-            case (Enums::PieceType::Knight):
-                promoted_piece = std::make_unique<Knight>(moving_piece->GetColor());
-                break;
-            case (Enums::PieceType::Rook):
-                promoted_piece = std::make_unique<Rook>(moving_piece->GetColor());
-                break;
-            case (Enums::PieceType::Queen):
-                promoted_piece = std::make_unique<Queen>(moving_piece->GetColor());
-                break;
-            default:
-                promoted_piece = std::make_unique<Queen>(moving_piece->GetColor());
-                break;
+            promoted_piece_type = Enums::PieceType::Queen;
         }
+
+        std::unique_ptr<Piece> promoted_piece = TakeSparePiece(moving_piece->GetColor(), promoted_piece_type);
         promoted_piece->SetHasMoved(true);
         PlacePieceAt(std::move(promoted_piece), to_position);
+        StoreSparePiece(std::move(moving_piece));
 
-        return std::move(record);
+        return record;
     }
 
     MoveRecord Board::MakeCastleMove(const Move &move)
     {
-        const Position &king_from_position = move.GetFromPosition();
-        const Position &king_to_position = move.GetToPosition();
+        const Position king_from_position = move.GetFromPosition();
+        const Position king_to_position = move.GetToPosition();
 
         auto [rook_from_position, rook_to_position] = GetCastleRookPositions(king_from_position, king_to_position, move.GetMoveType());
 
@@ -219,7 +354,7 @@ namespace GameLogic
         record.SetMoveMade(move);
 
         std::unique_ptr<Piece> king_piece = RemovePieceAt(king_from_position);
-        record.SetMovedPiece(king_piece->ClonePiece());
+        record.SetMovedPieceHasMoved(king_piece->HasMoved());
         king_piece->SetHasMoved(true);
         PlacePieceAt(std::move(king_piece), king_to_position);
 
@@ -227,64 +362,65 @@ namespace GameLogic
         rook_piece->SetHasMoved(true);
         PlacePieceAt(std::move(rook_piece), rook_to_position);
 
-        record.SetCapturedPiece(nullptr);
+        record.SetCapturedPiece(Bitboards::NO_PIECE, false);
 
-        return std::move(record);
+        return record;
     }
 
-    void Board::UnmakeNormalMove(MoveRecord &record)
+    void Board::UnmakeNormalMove(const MoveRecord &record)
     {
         const Move& move = record.ReadMoveMade();
-        const Position &from_position = move.GetFromPosition();
-        const Position &to_position = move.GetToPosition();
+        const Position from_position = move.GetFromPosition();
+        const Position to_position = move.GetToPosition();
 
-        std::unique_ptr<Piece> moved_piece = record.TakeMovedPiece();
-        std::unique_ptr<Piece> captured_piece = record.TakeCapturedPiece();
+        std::unique_ptr<Piece> moved_piece = RemovePieceAt(to_position);
+        moved_piece->SetHasMoved(record.ReadMovedPieceHasMoved());
 
-        PlacePieceAt(std::move(captured_piece), to_position);
+        PlacePieceAt(TakeCapturedPiece(record), to_position);
         PlacePieceAt(std::move(moved_piece), from_position);
     }
 
-    void Board::UnmakeEnPassantMove(MoveRecord &record)
+    void Board::UnmakeEnPassantMove(const MoveRecord &record)
     {
         const Move& move = record.ReadMoveMade();
-        const Position &from_position = move.GetFromPosition();
-        const Position &to_position = move.GetToPosition();
+        const Position from_position = move.GetFromPosition();
+        const Position to_position = move.GetToPosition();
         const Position capture_position(from_position.GetRow(), to_position.GetCol());
 
-        std::unique_ptr<Piece> moved_piece = record.TakeMovedPiece();
-        std::unique_ptr<Piece> captured_piece = record.TakeCapturedPiece();
-
-        // Remove the pawn that did the enpassant action.
-        RemovePieceAt(to_position);
+        // Take back the pawn that did the enpassant action.
+        std::unique_ptr<Piece> moved_piece = RemovePieceAt(to_position);
+        moved_piece->SetHasMoved(record.ReadMovedPieceHasMoved());
 
-        PlacePieceAt(std::move(captured_piece), capture_position);
+        PlacePieceAt(TakeCapturedPiece(record), capture_position);
         PlacePieceAt(std::move(moved_piece), from_position);
     }
 
-    void Board::UnmakePawnPromotionMove(MoveRecord &record)
+    void Board::UnmakePawnPromotionMove(const MoveRecord &record)
     {
         const Move& move = record.ReadMoveMade();
-        const Position &from_position = move.GetFromPosition();
-        const Position &to_position = move.GetToPosition();
+        const Position from_position = move.GetFromPosition();
+        const Position to_position = move.GetToPosition();
 
-        std::unique_ptr<Piece> moved_piece = record.TakeMovedPiece();
-        std::unique_ptr<Piece> captured_piece = record.TakeCapturedPiece();
+        // The promoted piece is replaced by a pawn of the same color
+        std::unique_ptr<Piece> promoted_piece = RemovePieceAt(to_position);
+        std::unique_ptr<Piece> moved_piece = TakeSparePiece(promoted_piece->GetColor(), Enums::PieceType::Pawn);
+        moved_piece->SetHasMoved(record.ReadMovedPieceHasMoved());
+        StoreSparePiece(std::move(promoted_piece));
 
-        PlacePieceAt(std::move(captured_piece), to_position);
+        PlacePieceAt(TakeCapturedPiece(record), to_position);
         PlacePieceAt(std::move(moved_piece), from_position);
     }
 
-    void Board::UnmakeCastleMove(MoveRecord &record)
+    void Board::UnmakeCastleMove(const MoveRecord &record)
     {
         const Move& move = record.ReadMoveMade();
-        const Position& king_from_position = move.GetFromPosition();
-        const Position& king_to_position = move.GetToPosition();
+        const Position king_from_position = move.GetFromPosition();
+        const Position king_to_position = move.GetToPosition();
 
         auto [rook_from_position, rook_to_position] = GetCastleRookPositions(king_from_position, king_to_position, move.GetMoveType());
 
-        std::unique_ptr<Piece> king_piece = record.TakeMovedPiece();
-        king_piece->SetHasMoved(false);
+        std::unique_ptr<Piece> king_piece = RemovePieceAt(king_to_position);
+        king_piece->SetHasMoved(record.ReadMovedPieceHasMoved());
         std::unique_ptr<Piece> rook_piece = RemovePieceAt(rook_to_position);
         if (rook_piece)
         {
@@ -295,6 +431,46 @@ namespace GameLogic
         PlacePieceAt(std::move(rook_piece), rook_from_position);
     }
 
+    // Keep a piece taken off the board so a later move can put it back without allocating
+    void Board::StoreSparePiece(std::unique_ptr<Piece> piece)
+    {
+        if (piece == nullptr)
+        {
+            return;
+        }
+
+        const int piece_index = Bitboards::PieceIndex(piece->GetColor(), piece->GetPieceType());
+        this->spare_pieces_[piece_index].push_back(std::move(piece));
+    }
+
+    // Reuse a spare piece of the given color and type, only the first use of a type allocates
+    std::unique_ptr<Piece> Board::TakeSparePiece(Enums::Color color, Enums::PieceType piece_type)
+    {
+        std::vector<std::unique_ptr<Piece>> &spare_pieces = this->spare_pieces_[Bitboards::PieceIndex(color, piece_type)];
+        if (spare_pieces.empty())
+        {
+            return CreatePiece(color, piece_type);
+        }
+
+        std::unique_ptr<Piece> piece = std::move(spare_pieces.back());
+        spare_pieces.pop_back();
+        return piece;
+    }
+
+    // Put back the piece a record says was captured, with the has moved flag it had
+    std::unique_ptr<Piece> Board::TakeCapturedPiece(const MoveRecord &record)
+    {
+        const int piece_index = record.ReadCapturedPiece();
+        if (piece_index == Bitboards::NO_PIECE)
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<Piece> captured_piece = TakeSparePiece(Bitboards::PieceIndexColor(piece_index), Bitboards::PieceIndexType(piece_index));
+        captured_piece->SetHasMoved(record.ReadCapturedPieceHasMoved());
+        return captured_piece;
+    }
+
     std::pair<Position, Position> Board::GetCastleRookPositions(
         const Position& king_from_position, const Position& king_to_position, Enums::MoveType move_type) const
     {
@@ -312,12 +488,41 @@ namespace GameLogic
                 return {rook_from_position, rook_to_position};
     }
 
+    // Flip the square of a piece in its color and piece type bitboards
+    void Board::ToggleBitboards(const Piece *piece, int square)
+    {
+        if (piece == nullptr)
+        {
+            return;
+        }
+
+        const Bitboard square_bb = Bitboards::SquareBB(square);
+        const int piece_index = Bitboards::PieceIndex(piece->GetColor(), piece->GetPieceType());
+        this->piece_bitboards_[piece_index] ^= square_bb;
+        this->color_bitboards_[Bitboards::ColorIndex(piece->GetColor())] ^= square_bb;
+        this->zobrist_key_ ^= Zobrist::PieceKey(piece->GetColor(), piece->GetPieceType(), square);
+
+        // The bit is set after the toggle when the piece was placed, clear when it was removed
+        const bool is_placed = (this->piece_bitboards_[piece_index] & square_bb) != Bitboards::EMPTY;
+        const std::uint64_t signature = Bitboards::MaterialSignature(piece->GetColor(), piece->GetPieceType());
+
+        this->piece_counts_[piece_index] += is_placed ? 1 : -1;
+        this->material_signature_ = is_placed ? this->material_signature_ + signature : this->material_signature_ - signature;
+
+        if (piece->GetPieceType() == Enums::PieceType::King)
+        {
+            this->king_squares_[Bitboards::ColorIndex(piece->GetColor())] = is_placed ? square : Bitboards::NO_SQUARE;
+        }
+    }
+
     // Removes a Piece object from a position on the board
     std::unique_ptr<Piece> Board::RemovePieceAt(const Position &position)
     {
         if (IsPositionOnBoard(position))
         {
-            return std::move(this->board_[position.GetRow()][position.GetCol()]);
+            const int square = Bitboards::ToSquare(position);
+            ToggleBitboards(this->board_[square].get(), square);
+            return std::move(this->board_[square]);
         }
         else
         {
@@ -325,12 +530,15 @@ namespace GameLogic
         }
     }
 
-    // Place a Piece object at a position on the board
+    // Place a Piece object at a position on the board, replacing any piece already there
     void Board::PlacePieceAt(std::unique_ptr<Piece> piece, const Position &position)
     {
         if (IsPositionOnBoard(position))
         {
-            this->board_[position.GetRow()][position.GetCol()] = std::move(piece);
+            const int square = Bitboards::ToSquare(position);
+            ToggleBitboards(this->board_[square].get(), square);
+            ToggleBitboards(piece.get(), square);
+            this->board_[square] = std::move(piece);
         }
     }
 
@@ -339,7 +547,7 @@ namespace GameLogic
     {
         if (IsPositionOnBoard(position))
         {
-            return this->board_[position.GetRow()][position.GetCol()].get();
+            return this->board_[Bitboards::ToSquare(position)].get();
         }
         else
         {
@@ -352,16 +560,11 @@ namespace GameLogic
     {
         std::map<Position, const Piece *> position_with_piece;
 
-        for (int row = 0; row < Constants::BOARD_SIZE; row++)
+        Bitboard occupied = GetOccupiedBitboard();
+        while (occupied)
         {
-            for (int col = 0; col < Constants::BOARD_SIZE; col++)
-            {
-                const Piece *piece = GetPieceAt(Position(row, col));
-                if (piece != nullptr)
-                {
-                    position_with_piece[Position(row, col)] = piece;
-                }
-            }
+            const int square = Bitboards::PopLowestSquare(occupied);
+            position_with_piece[Bitboards::ToPosition(square)] = this->board_[square].get();
         }
         return position_with_piece;
     }
@@ -371,7 +574,7 @@ namespace GameLogic
     {
         if (IsPositionOnBoard(position))
         {
-            return this->board_[position.GetRow()][position.GetCol()].get();
+            return this->board_[Bitboards::ToSquare(position)].get();
         }
         else
         {
@@ -379,6 +582,117 @@ namespace GameLogic
         }
     }
 
+    // Returns the square of the king of the given color
+    int Board::GetKingSquare(Enums::Color color) const
+    {
+        return this->king_squares_[Bitboards::ColorIndex(color)];
+    }
+
+    // Returns how many pieces of the given color and type are on the board
+    int Board::GetPieceCount(Enums::Color color, Enums::PieceType piece_type) const
+    {
+        return this->piece_counts_[Bitboards::PieceIndex(color, piece_type)];
+    }
+
+    // Returns the material signature of every piece on the board
+    std::uint64_t Board::GetMaterialSignature() const
+    {
+        return this->material_signature_;
+    }
+
+    // Returns the squares holding a piece of the given color and type
+    Bitboard Board::GetPieceBitboard(Enums::Color color, Enums::PieceType piece_type) const
+    {
+        return this->piece_bitboards_[Bitboards::PieceIndex(color, piece_type)];
+    }
+
+    // Returns the squares holding a piece of the given color
+    Bitboard Board::GetColorBitboard(Enums::Color color) const
+    {
+        return this->color_bitboards_[Bitboards::ColorIndex(color)];
+    }
+
+    // Returns the squares holding any piece
+    Bitboard Board::GetOccupiedBitboard() const
+    {
+        return this->color_bitboards_[0] | this->color_bitboards_[1];
+    }
+
+    Enums::Color Board::GetSideToMove() const
+    {
+        return this->side_to_move_;
+    }
+
+    int Board::GetCastlingRights() const
+    {
+        return this->castling_rights_;
+    }
+
+    int Board::GetEnPassantSquare() const
+    {
+        return this->en_passant_square_;
+    }
+
+    ZobristKey Board::GetZobristKey() const
+    {
+        return this->zobrist_key_;
+    }
+
+    void Board::SetPositionState(Enums::Color side_to_move, int castling_rights, int en_passant_square)
+    {
+        this->side_to_move_ = side_to_move;
+        this->castling_rights_ = castling_rights;
+        this->en_passant_square_ = en_passant_square;
+        this->zobrist_key_ = ComputeZobristKey();
+
+        Bitboard occupied = GetOccupiedBitboard();
+        while (occupied)
+        {
+            const int square = Bitboards::PopLowestSquare(occupied);
+            Piece *piece = this->board_[square].get();
+            piece->SetHasMoved(DeriveHasMoved(piece->GetColor(), piece->GetPieceType(), square, castling_rights));
+        }
+    }
+
+    // Swap the pieces through the spare pool, so loading a snapshot into a warm Board does not allocate
+    void Board::LoadPositionState(const PositionState &state)
+    {
+        StoreAllPieces();
+
+        Bitboard occupied = state.GetOccupiedBitboard();
+        while (occupied)
+        {
+            const int square = Bitboards::PopLowestSquare(occupied);
+            const int piece_index = state.GetPieceAt(square);
+            PlacePieceAt(TakeSparePiece(Bitboards::PieceIndexColor(piece_index), Bitboards::PieceIndexType(piece_index)), Bitboards::ToPosition(square));
+        }
+
+        SetPositionState(state.GetSideToMove(), state.GetCastlingRights(), state.GetEnPassantSquare());
+    }
+
+    void Board::PlacePieces(const std::array<int, Bitboards::SQUARE_COUNT> &pieces)
+    {
+        StoreAllPieces();
+
+        for (int square = 0; square < Bitboards::SQUARE_COUNT; square++)
+        {
+            const int piece_index = pieces[square];
+            if (piece_index != Bitboards::NO_PIECE)
+            {
+                PlacePieceAt(TakeSparePiece(Bitboards::PieceIndexColor(piece_index), Bitboards::PieceIndexType(piece_index)), Bitboards::ToPosition(square));
+            }
+        }
+    }
+
+    void Board::StoreAllPieces()
+    {
+        Bitboard occupied = GetOccupiedBitboard();
+        while (occupied)
+        {
+            StoreSparePiece(RemovePieceAt(Bitboards::ToPosition(Bitboards::PopLowestSquare(occupied))));
+        }
+    }
+
 
     // Returns true if the given position is on the board
     bool Board::IsPositionOnBoard(const Position& position) const
@@ -390,7 +704,8 @@ namespace GameLogic
     // Returns true if the no piece exist on the given position on the board
     bool Board::IsPositionEmpty(const Position& position) const
     {
-        return (IsPositionOnBoard(position) && GetPieceAt(position) == nullptr);
+        return IsPositionOnBoard(position)
+            && !Bitboards::Contains(GetOccupiedBitboard(), Bitboards::ToSquare(position));
     }
 
     // Returns true if a list of specified positions are empty
@@ -0,0 +1,408 @@
+#include "game_logic/base/fen.hpp"
+#include "game_logic/base/attacks.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/piece.hpp"
+#include "game_logic/base/position.hpp"
+
+#include "game_logic/enums.hpp"
+#include "game_logic/constants.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace GameLogic
+{
+    namespace Fen
+    {
+        namespace
+        {
+            // FEN piece letters in Bitboards::PieceIndex order
+            constexpr std::string_view PIECE_SYMBOLS = "PNBRQKpnbrqk";
+
+            // The castling letters in the order FEN lists them, with their Constants::CASTLE_* bit
+            constexpr std::array<std::pair<char, int>, 4> CASTLING_SYMBOLS =
+            {{
+                {'K', Constants::CASTLE_LIGHT_KS},
+                {'Q', Constants::CASTLE_LIGHT_QS},
+                {'k', Constants::CASTLE_DARK_KS},
+                {'q', Constants::CASTLE_DARK_QS},
+            }};
+
+            // Split the FEN into its space separated fields, missing fields are left empty
+            std::array<std::string_view, 6> SplitFields(std::string_view fen)
+            {
+                std::array<std::string_view, 6> fields{};
+                std::size_t field_count = 0;
+
+                while (!fen.empty() && field_count < fields.size())
+                {
+                    const std::size_t start = fen.find_first_not_of(' ');
+                    if (start == std::string_view::npos)
+                    {
+                        break;
+                    }
+                    fen.remove_prefix(start);
+
+                    const std::size_t end = std::min(fen.find(' '), fen.size());
+                    fields[field_count++] = fen.substr(0, end);
+                    fen.remove_prefix(end);
+                }
+                return fields;
+            }
+
+            int ParseCounter(std::string_view field, int default_value, const std::string &fen)
+            {
+                if (field.empty())
+                {
+                    return default_value;
+                }
+
+                int value = 0;
+                const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+                if (error != std::errc() || end != field.data() + field.size() || value < 0)
+                {
+                    throw std::invalid_argument("Invalid FEN counter: " + fen);
+                }
+                return value;
+            }
+
+            // The most pawns and pieces one side can have, which keeps every piece count within its material signature field
+            constexpr int MAX_PAWN_COUNT = 8;
+            constexpr int MAX_PIECE_COUNT = 16;
+
+            /** @brief The pieces of a placement field, read before the Board is touched. */
+            struct Placement
+            {
+                /** @brief The piece index on every square, Bitboards::NO_PIECE if empty. */
+                std::array<int, Bitboards::SQUARE_COUNT> pieces;
+
+                /** @brief The squares of every piece index. */
+                std::array<Bitboard, Bitboards::PIECE_COUNT> bitboards;
+
+                /** @brief Every occupied square. */
+                Bitboard occupied;
+
+                Bitboard GetPieceBitboard(Enums::Color color, Enums::PieceType piece_type) const
+                {
+                    return this->bitboards[Bitboards::PieceIndex(color, piece_type)];
+                }
+            };
+
+            // Read the placement field, so a malformed FEN leaves the Board as it was
+            bool ParsePiecePlacement(std::string_view piece_placement, Placement &placement)
+            {
+                placement.pieces.fill(Bitboards::NO_PIECE);
+                placement.bitboards.fill(Bitboards::EMPTY);
+                placement.occupied = Bitboards::EMPTY;
+
+                int row = 0;
+                int col = 0;
+
+                for (char symbol : piece_placement)
+                {
+                    if (symbol == '/')
+                    {
+                        if (col != Constants::BOARD_SIZE)
+                        {
+                            return false;
+                        }
+                        row++;
+                        col = 0;
+                        continue;
+                    }
+
+                    if (row >= Constants::BOARD_SIZE)
+                    {
+                        return false;
+                    }
+
+                    if (symbol >= '1' && symbol <= '8')
+                    {
+                        col += symbol - '0';
+                    }
+                    else if (PIECE_SYMBOLS.find(symbol) != std::string_view::npos && col < Constants::BOARD_SIZE)
+                    {
+                        const int piece_index = static_cast<int>(PIECE_SYMBOLS.find(symbol));
+                        const int square = Bitboards::ToSquare(row, col);
+
+                        placement.pieces[square] = piece_index;
+                        placement.bitboards[piece_index] |= Bitboards::SquareBB(square);
+                        placement.occupied |= Bitboards::SquareBB(square);
+                        col++;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+
+                    if (col > Constants::BOARD_SIZE)
+                    {
+                        return false;
+                    }
+                }
+
+                return row == Constants::BOARD_SIZE - 1 && col == Constants::BOARD_SIZE;
+            }
+
+            bool IsSquareAttacked(const Placement &placement, int square, Enums::Color attacker_color)
+            {
+                const Enums::Color defender_color = (attacker_color == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+                const Bitboard queens = placement.GetPieceBitboard(attacker_color, Enums::PieceType::Queen);
+
+                return (Attacks::PawnAttacks(defender_color, square) & placement.GetPieceBitboard(attacker_color, Enums::PieceType::Pawn))
+                    || (Attacks::KnightAttacks(square) & placement.GetPieceBitboard(attacker_color, Enums::PieceType::Knight))
+                    || (Attacks::KingAttacks(square) & placement.GetPieceBitboard(attacker_color, Enums::PieceType::King))
+                    || (Attacks::BishopAttacks(square, placement.occupied)
+                        & (placement.GetPieceBitboard(attacker_color, Enums::PieceType::Bishop) | queens))
+                    || (Attacks::RookAttacks(square, placement.occupied)
+                        & (placement.GetPieceBitboard(attacker_color, Enums::PieceType::Rook) | queens));
+            }
+
+            // Reject what the move generator can't handle: a missing or extra King, pawns on the first
+            // or last rank, more pieces than a side starts with, or a side that can capture the enemy King
+            void ValidatePosition(const Placement &placement, Enums::Color side_to_move, const std::string &fen)
+            {
+                for (Enums::Color color : {Enums::Color::Light, Enums::Color::Dark})
+                {
+                    int piece_count = 0;
+                    for (Enums::PieceType piece_type : Constants::AllPieceType)
+                    {
+                        piece_count += Bitboards::PopCount(placement.GetPieceBitboard(color, piece_type));
+                    }
+
+                    const Bitboard pawns = placement.GetPieceBitboard(color, Enums::PieceType::Pawn);
+                    if (Bitboards::PopCount(placement.GetPieceBitboard(color, Enums::PieceType::King)) != 1
+                        || Bitboards::PopCount(pawns) > MAX_PAWN_COUNT
+                        || piece_count > MAX_PIECE_COUNT
+                        || (pawns & (Bitboards::RANK_1 | Bitboards::RANK_8)))
+                    {
+                        throw std::invalid_argument("Invalid FEN piece placement: " + fen);
+                    }
+                }
+
+                const Enums::Color waiting_color = (side_to_move == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+                const int waiting_king_square = Bitboards::LowestSquare(placement.GetPieceBitboard(waiting_color, Enums::PieceType::King));
+                if (IsSquareAttacked(placement, waiting_king_square, side_to_move))
+                {
+                    throw std::invalid_argument("Invalid FEN, the side not to move is in check: " + fen);
+                }
+            }
+
+            // Drop the castling rights whose King or Rook is not on its starting square
+            int GetPossibleCastlingRights(const Placement &placement, int castling_rights)
+            {
+                struct CastlingPieces
+                {
+                    int castling_right;
+                    Enums::Color color;
+                    int king_square;
+                    int rook_square;
+                };
+
+                constexpr CastlingPieces castling_pieces[] =
+                {
+                    {Constants::CASTLE_LIGHT_KS, Enums::Color::Light, Bitboards::ToSquare(7, 4), Bitboards::ToSquare(7, 7)},
+                    {Constants::CASTLE_LIGHT_QS, Enums::Color::Light, Bitboards::ToSquare(7, 4), Bitboards::ToSquare(7, 0)},
+                    {Constants::CASTLE_DARK_KS, Enums::Color::Dark, Bitboards::ToSquare(0, 4), Bitboards::ToSquare(0, 7)},
+                    {Constants::CASTLE_DARK_QS, Enums::Color::Dark, Bitboards::ToSquare(0, 4), Bitboards::ToSquare(0, 0)},
+                };
+
+                for (const CastlingPieces &pieces : castling_pieces)
+                {
+                    if (placement.pieces[pieces.king_square] != Bitboards::PieceIndex(pieces.color, Enums::PieceType::King)
+                        || placement.pieces[pieces.rook_square] != Bitboards::PieceIndex(pieces.color, Enums::PieceType::Rook))
+                    {
+                        castling_rights &= ~pieces.castling_right;
+                    }
+                }
+                return castling_rights;
+            }
+
+            // Drop an en passant target that no double pawn push of the side not to move could have left
+            int GetPossibleEnPassantSquare(const Placement &placement, Enums::Color side_to_move, int en_passant_square)
+            {
+                if (en_passant_square == Bitboards::NO_SQUARE)
+                {
+                    return en_passant_square;
+                }
+
+                // Light captures onto rank 6 (row 2), Dark onto rank 3 (row 5); the pawn passed from one row further
+                const bool is_light_to_move = side_to_move == Enums::Color::Light;
+                const int target_row = is_light_to_move ? 2 : 5;
+                const int direction = is_light_to_move ? Constants::BOARD_SIZE : -Constants::BOARD_SIZE;
+                const Enums::Color pushed_color = is_light_to_move ? Enums::Color::Dark : Enums::Color::Light;
+
+                if (en_passant_square / Constants::BOARD_SIZE != target_row
+                    || placement.pieces[en_passant_square] != Bitboards::NO_PIECE
+                    || placement.pieces[en_passant_square - direction] != Bitboards::NO_PIECE
+                    || placement.pieces[en_passant_square + direction] != Bitboards::PieceIndex(pushed_color, Enums::PieceType::Pawn))
+                {
+                    return Bitboards::NO_SQUARE;
+                }
+                return en_passant_square;
+            }
+
+            char *WriteCounter(char *out, char *buffer_end, int value)
+            {
+                return std::to_chars(out, buffer_end, value).ptr;
+            }
+        } // namespace
+
+        FenClocks LoadFen(const std::string &fen, Board &board)
+        {
+            const std::array<std::string_view, 6> fields = SplitFields(fen);
+            const std::string_view piece_placement = fields[0];
+            const std::string_view active_color = fields[1];
+            const std::string_view castling_field = fields[2];
+            const std::string_view en_passant_field = fields[3];
+
+            if (piece_placement.empty() || (active_color != "w" && active_color != "b"))
+            {
+                throw std::invalid_argument("Invalid FEN: " + fen);
+            }
+
+            int castling_rights = Constants::CASTLE_NONE;
+            if (castling_field != "-")
+            {
+                for (char symbol : castling_field)
+                {
+                    bool is_known = false;
+                    for (const auto &[castling_symbol, castling_right] : CASTLING_SYMBOLS)
+                    {
+                        if (symbol == castling_symbol)
+                        {
+                            castling_rights |= castling_right;
+                            is_known = true;
+                        }
+                    }
+                    if (!is_known)
+                    {
+                        throw std::invalid_argument("Invalid FEN castling rights: " + fen);
+                    }
+                }
+            }
+
+            int en_passant_square = Bitboards::NO_SQUARE;
+            if (!en_passant_field.empty() && en_passant_field != "-")
+            {
+                if (en_passant_field.size() != 2
+                ||  en_passant_field[0] < 'a' || en_passant_field[0] > 'h'
+                ||  (en_passant_field[1] != '3' && en_passant_field[1] != '6'))
+                {
+                    throw std::invalid_argument("Invalid FEN en passant square: " + fen);
+                }
+                en_passant_square = Bitboards::ToSquare(Position::AlgebraicToPosition(en_passant_field[0], en_passant_field[1]));
+            }
+
+            const FenClocks clocks{ParseCounter(fields[4], 0, fen), ParseCounter(fields[5], 1, fen)};
+
+            Placement placement;
+            if (!ParsePiecePlacement(piece_placement, placement))
+            {
+                throw std::invalid_argument("Invalid FEN piece placement: " + fen);
+            }
+
+            const Enums::Color side_to_move = (active_color == "w") ? Enums::Color::Light : Enums::Color::Dark;
+            ValidatePosition(placement, side_to_move, fen);
+
+            castling_rights = GetPossibleCastlingRights(placement, castling_rights);
+            en_passant_square = GetPossibleEnPassantSquare(placement, side_to_move, en_passant_square);
+
+            board.PlacePieces(placement.pieces);
+            board.SetPositionState(side_to_move, castling_rights, en_passant_square);
+
+            return clocks;
+        }
+
+        std::size_t WriteFen(const Board &board, const FenClocks &clocks, char *buffer, std::size_t buffer_size)
+        {
+            if (buffer_size < MAX_FEN_LENGTH)
+            {
+                throw std::length_error("FEN buffer must hold at least MAX_FEN_LENGTH characters");
+            }
+
+            char *out = buffer;
+            char *const buffer_end = buffer + buffer_size - 1;
+
+            // Part 1: piece placement, rank 8 first
+            for (int row = 0; row < Constants::BOARD_SIZE; row++)
+            {
+                int empty_squares = 0;
+
+                for (int col = 0; col < Constants::BOARD_SIZE; col++)
+                {
+                    const Piece *piece = board.GetPieceAt(Position{row, col});
+                    if (piece == nullptr)
+                    {
+                        empty_squares++;
+                        continue;
+                    }
+
+                    if (empty_squares > 0)
+                    {
+                        *out++ = static_cast<char>('0' + empty_squares);
+                        empty_squares = 0;
+                    }
+                    *out++ = PIECE_SYMBOLS[Bitboards::PieceIndex(piece->GetColor(), piece->GetPieceType())];
+                }
+
+                if (empty_squares > 0)
+                {
+                    *out++ = static_cast<char>('0' + empty_squares);
+                }
+                if (row < Constants::BOARD_SIZE - 1)
+                {
+                    *out++ = '/';
+                }
+            }
+
+            // Part 2: active color
+            *out++ = ' ';
+            *out++ = (board.GetSideToMove() == Enums::Color::Light) ? 'w' : 'b';
+
+            // Part 3: castling rights
+            *out++ = ' ';
+            const int castling_rights = board.GetCastlingRights();
+            if (castling_rights == Constants::CASTLE_NONE)
+            {
+                *out++ = '-';
+            }
+            for (const auto &[castling_symbol, castling_right] : CASTLING_SYMBOLS)
+            {
+                if (castling_rights & castling_right)
+                {
+                    *out++ = castling_symbol;
+                }
+            }
+
+            // Part 4: en passant target
+            *out++ = ' ';
+            const int en_passant_square = board.GetEnPassantSquare();
+            if (en_passant_square == Bitboards::NO_SQUARE)
+            {
+                *out++ = '-';
+            }
+            else
+            {
+                *out++ = static_cast<char>('a' + en_passant_square % Constants::BOARD_SIZE);
+                *out++ = static_cast<char>('8' - en_passant_square / Constants::BOARD_SIZE);
+            }
+
+            // Part 5 and 6: halfmove clock and fullmove number
+            *out++ = ' ';
+            out = WriteCounter(out, buffer_end, clocks.halfmove_clock);
+            *out++ = ' ';
+            out = WriteCounter(out, buffer_end, clocks.fullmove_number);
+
+            *out = '\0';
+            return static_cast<std::size_t>(out - buffer);
+        }
+    } // namespace Fen
+} // namespace GameLogic
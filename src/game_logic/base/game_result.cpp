@@ -47,6 +47,20 @@ namespace GameLogic
         return player_color_;
     }
 
+    // Returns the result in PGN notation
+    const char *GameResult::GetPgnResult() const noexcept
+    {
+        switch (game_state_)
+        {
+            case (Enums::GameState::Ongoing):
+                return "*";
+            case (Enums::GameState::Checkmate):
+                return (player_color_ == Enums::Color::Light) ? "1-0" : "0-1";
+            default:
+                return "1/2-1/2";
+        }
+    }
+
     // Reset the game result
     void GameResult::Reset()
     {
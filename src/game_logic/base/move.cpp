@@ -1,23 +1,51 @@
 #include "game_logic/base/move.hpp"
 #include "game_logic/base/position.hpp"
+#include "game_logic/base/bitboard.hpp"
 
 #include "game_logic/enums.hpp"
+#include "game_logic/constants.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 namespace GameLogic
 {
+    namespace
+    {
+        constexpr int TO_SQUARE_SHIFT = 6;
+        constexpr int FLAG_SHIFT = 12;
+        constexpr std::uint16_t SQUARE_MASK = 0x3F;
+        constexpr std::uint16_t SQUARES_MASK = 0xFFF;
+
+        // Flags below PROMOTION_FLAG are a MoveType, from PROMOTION_FLAG up they are a
+        // PawnPromotion with the promotion PieceType added on top
+        constexpr int PROMOTION_FLAG = 8;
+
+        std::uint16_t PackMove(Enums::MoveType move_type, int from_square, int to_square)
+        {
+            const int flag = (move_type == Enums::MoveType::PawnPromotion)
+                           ? PROMOTION_FLAG + static_cast<int>(Enums::PieceType::None)
+                           : static_cast<int>(move_type);
+
+            return static_cast<std::uint16_t>(from_square | (to_square << TO_SQUARE_SHIFT) | (flag << FLAG_SHIFT));
+        }
+    } // namespace
+
     // Construct a Move object with move type, from position and to position
     Move::Move(Enums::MoveType move_type, const Position &from_position, const Position &to_position)
-        : move_type_(move_type), from_position_(from_position), to_position_(to_position), promotion_piece_type_(Enums::PieceType::None) {};
+        : data_(PackMove(move_type, Bitboards::ToSquare(from_position), Bitboards::ToSquare(to_position))) {};
+
+    // Construct a Move object with move type, from square and to square
+    Move::Move(Enums::MoveType move_type, int from_square, int to_square)
+        : data_(PackMove(move_type, from_square, to_square)) {};
 
     // Returns true if move type, start, and destination are equal
     bool Move::operator==(const Move& other_move) const
     {
-        return this->move_type_ == other_move.move_type_
-            && this->from_position_ == other_move.from_position_
-            && this->to_position_ == other_move.to_position_;
+        return (this->data_ & SQUARES_MASK) == (other_move.data_ & SQUARES_MASK)
+            && GetMoveType() == other_move.GetMoveType();
     }
 
     std::tuple<Position, Position, Enums::PieceType> Move::FromUCI(const std::string &uci_string)
@@ -60,28 +88,76 @@ namespace GameLogic
         return std::make_tuple(from_position, to_position, promotion_piece_type);
     }
 
+    // Castling is written as the king's two square move, as UCI expects
+    std::string Move::ToUCI() const
+    {
+        std::string uci_string;
+        uci_string.reserve(5);
+
+        for (int square : {GetFromSquare(), GetToSquare()})
+        {
+            uci_string += static_cast<char>('a' + square % Constants::BOARD_SIZE);
+            uci_string += static_cast<char>('8' - square / Constants::BOARD_SIZE);
+        }
+
+        if (GetMoveType() == Enums::MoveType::PawnPromotion)
+        {
+            switch (GetPromotionPieceType())
+            {
+                case (Enums::PieceType::Bishop):
+                    uci_string += 'b';
+                    break;
+                case (Enums::PieceType::Knight):
+                    uci_string += 'n';
+                    break;
+                case (Enums::PieceType::Rook):
+                    uci_string += 'r';
+                    break;
+                default:
+                    uci_string += 'q';
+                    break;
+            }
+        }
+
+        return uci_string;
+    }
+
     // Return the type of the move (Normal, KSCastle, QSCastle ...)
     Enums::MoveType Move::GetMoveType() const
     {
-        return this->move_type_;
+        const int flag = this->data_ >> FLAG_SHIFT;
+        return (flag >= PROMOTION_FLAG) ? Enums::MoveType::PawnPromotion : static_cast<Enums::MoveType>(flag);
     }
 
     // Return the position the piece is moving from
-    const Position& Move::GetFromPosition() const
+    Position Move::GetFromPosition() const
     {
-        return this->from_position_;
+        return Bitboards::ToPosition(GetFromSquare());
     }
 
     // Return the position the piece is moving to
-    const Position& Move::GetToPosition() const
+    Position Move::GetToPosition() const
+    {
+        return Bitboards::ToPosition(GetToSquare());
+    }
+
+    // Return the square the piece is moving from
+    int Move::GetFromSquare() const
     {
-        return this->to_position_;
+        return this->data_ & SQUARE_MASK;
+    }
+
+    // Return the square the piece is moving to
+    int Move::GetToSquare() const
+    {
+        return (this->data_ >> TO_SQUARE_SHIFT) & SQUARE_MASK;
     }
 
     // Return the piece that the pawn will promote to.
     Enums::PieceType Move::GetPromotionPieceType() const
     {
-        return this->promotion_piece_type_;
+        const int flag = this->data_ >> FLAG_SHIFT;
+        return (flag >= PROMOTION_FLAG) ? static_cast<Enums::PieceType>(flag - PROMOTION_FLAG) : Enums::PieceType::None;
     }
 
     void Move::SetPromotionPieceType(Enums::PieceType promotion_piece_type)
@@ -90,7 +166,14 @@ namespace GameLogic
         {
             throw std::invalid_argument("Invalid promotion piece type: King or Pawn.");
         }
-        this->promotion_piece_type_ = promotion_piece_type;
+
+        if (GetMoveType() != Enums::MoveType::PawnPromotion)
+        {
+            return;
+        }
+
+        const int flag = PROMOTION_FLAG + static_cast<int>(promotion_piece_type);
+        this->data_ = static_cast<std::uint16_t>((this->data_ & SQUARES_MASK) | (flag << FLAG_SHIFT));
     }
 
 } // namespace GameLogic
\ No newline at end of file
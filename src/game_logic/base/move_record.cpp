@@ -1,7 +1,7 @@
 #include "game_logic/base/move_record.hpp"
 #include "game_logic/base/move.hpp"
 
-#include <memory>
+#include <cstdint>
 
 namespace GameLogic
 {
@@ -10,14 +10,19 @@ namespace GameLogic
         return this->move_made_;
     }
 
-    const Piece* MoveRecord::ReadCapturedPiece() const
+    int MoveRecord::ReadCapturedPiece() const
     {
-        return this->captured_piece_.get();
+        return this->captured_piece_;
     }
 
-    const Piece* MoveRecord::ReadMovedPiece() const
+    bool MoveRecord::ReadCapturedPieceHasMoved() const
     {
-        return this->moved_piece_.get();
+        return this->captured_piece_has_moved_;
+    }
+
+    bool MoveRecord::ReadMovedPieceHasMoved() const
+    {
+        return this->moved_piece_has_moved_;
     }
 
     int MoveRecord::ReadPrevFiftyMoveCounter() const
@@ -25,14 +30,19 @@ namespace GameLogic
         return this->prev_fifty_move_counter_;
     }
 
-    std::unique_ptr<Piece> MoveRecord::TakeCapturedPiece()
+    int MoveRecord::ReadPrevCastlingRights() const
     {
-        return std::move(this->captured_piece_);
+        return this->prev_castling_rights_;
     }
 
-    std::unique_ptr<Piece> MoveRecord::TakeMovedPiece()
+    int MoveRecord::ReadPrevEnPassantSquare() const
     {
-        return std::move(this->moved_piece_);
+        return this->prev_en_passant_square_;
+    }
+
+    ZobristKey MoveRecord::ReadPrevZobristKey() const
+    {
+        return this->prev_zobrist_key_;
     }
 
     void MoveRecord::SetMoveMade(const Move& move)
@@ -40,18 +50,26 @@ namespace GameLogic
         this->move_made_ = move;
     }
 
-    void MoveRecord::SetCapturedPiece(std::unique_ptr<Piece> captured_piece)
+    void MoveRecord::SetCapturedPiece(int piece_index, bool has_moved)
     {
-        this->captured_piece_ = std::move(captured_piece);
+        this->captured_piece_ = static_cast<std::uint8_t>(piece_index);
+        this->captured_piece_has_moved_ = has_moved;
     }
 
-    void MoveRecord::SetMovedPiece(std::unique_ptr<Piece> moved_piece)
+    void MoveRecord::SetMovedPieceHasMoved(bool has_moved)
     {
-        this->moved_piece_ = std::move(moved_piece);
+        this->moved_piece_has_moved_ = has_moved;
     }
 
     void MoveRecord::SetPrevFiftyMoveCounter(int counter)
     {
-        this->prev_fifty_move_counter_ = counter;
+        this->prev_fifty_move_counter_ = static_cast<std::uint16_t>(counter);
+    }
+
+    void MoveRecord::SetPrevBoardState(int castling_rights, int en_passant_square, ZobristKey zobrist_key)
+    {
+        this->prev_castling_rights_ = static_cast<std::uint8_t>(castling_rights);
+        this->prev_en_passant_square_ = static_cast<std::int8_t>(en_passant_square);
+        this->prev_zobrist_key_ = zobrist_key;
     }
-} // namespace GameLogic
\ No newline at end of file
+} // namespace GameLogic
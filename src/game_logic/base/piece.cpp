@@ -1,6 +1,7 @@
 #include "game_logic/base/board.hpp"
 #include "game_logic/base/piece.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/direction.hpp"
 
@@ -16,6 +17,15 @@ namespace GameLogic
     Piece::Piece(Enums::PieceType piece_type, Enums::Color color)
         : piece_type_(piece_type), color_(color), has_moved_(false), has_promoted_(false) {};
 
+    // Collect the potential moves of the piece into a vector
+    std::vector<Move> Piece::GetPotentialMoves(
+        const Position& from_position, const Board& board, const Move* last_move) const
+    {
+        MoveList moves;
+        GeneratePotentialMoves(from_position, board, moves, last_move);
+        return moves.ToVector();
+    }
+
     // Get all positions a piece can move to from its current position (in EXACTLY ONE Direction)
     std::vector<Position> Piece::GetPositionsInDir(
         const Position& from_position, const Board& board, const Direction& direction) const
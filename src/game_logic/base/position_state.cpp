@@ -0,0 +1,199 @@
+#include "game_logic/base/position_state.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/zobrist.hpp"
+
+#include "game_logic/enums.hpp"
+#include "game_logic/constants.hpp"
+
+#include <cstdint>
+
+namespace GameLogic
+{
+    PositionState::PositionState(const Board &board, int halfmove_clock, int fullmove_number)
+        : zobrist_key_(board.GetZobristKey()),
+        halfmove_clock_(static_cast<std::uint16_t>(halfmove_clock)),
+        fullmove_number_(static_cast<std::uint16_t>(fullmove_number)),
+        side_to_move_(static_cast<std::uint8_t>(Bitboards::ColorIndex(board.GetSideToMove()))),
+        castling_rights_(static_cast<std::uint8_t>(board.GetCastlingRights())),
+        en_passant_square_(static_cast<std::int8_t>(board.GetEnPassantSquare()))
+    {
+        for (int piece_index = 0; piece_index < Bitboards::PIECE_COUNT; piece_index++)
+        {
+            const Enums::Color color = Bitboards::PieceIndexColor(piece_index);
+            Bitboard pieces = board.GetPieceBitboard(color, Bitboards::PieceIndexType(piece_index));
+
+            this->piece_bitboards_[piece_index] = pieces;
+            this->color_bitboards_[Bitboards::ColorIndex(color)] |= pieces;
+
+            while (pieces)
+            {
+                this->squares_[Bitboards::PopLowestSquare(pieces)] = static_cast<std::uint8_t>(piece_index);
+            }
+        }
+    }
+
+    // Copy make: the copy is updated the same way Board::MakeMove and Board::UpdatePositionState update the Board
+    PositionState PositionState::MakeMove(const Move &move) const
+    {
+        PositionState next = *this;
+
+        const int from_square = move.GetFromSquare();
+        const int to_square = move.GetToSquare();
+        const int moving_piece = next.squares_[from_square];
+        const Enums::Color moving_color = Bitboards::PieceIndexColor(moving_piece);
+        const Enums::MoveType move_type = move.GetMoveType();
+
+        // Take out the en passant key while the pawns that could capture are still in place
+        next.zobrist_key_ ^= next.GetEnPassantZobristKey();
+
+        // En passant captures beside the from square, every other capture on the to square
+        const int captured_square = (move_type == Enums::MoveType::EnPassant)
+                                  ? Bitboards::ToSquare(from_square / Constants::BOARD_SIZE, to_square % Constants::BOARD_SIZE)
+                                  : to_square;
+        const int captured_piece = next.squares_[captured_square];
+
+        if (captured_piece != Bitboards::NO_PIECE)
+        {
+            next.TogglePiece(captured_piece, captured_square);
+        }
+
+        switch (move_type)
+        {
+            case Enums::MoveType::PawnPromotion:
+            {
+                // No promotion piece chosen yet means a queen
+                const Enums::PieceType promotion_piece_type = (move.GetPromotionPieceType() == Enums::PieceType::None)
+                                                            ? Enums::PieceType::Queen
+                                                            : move.GetPromotionPieceType();
+                next.TogglePiece(moving_piece, from_square);
+                next.TogglePiece(Bitboards::PieceIndex(moving_color, promotion_piece_type), to_square);
+                break;
+            }
+
+            case Enums::MoveType::CastleKS:
+            case Enums::MoveType::CastleQS:
+            {
+                const bool is_king_side = move_type == Enums::MoveType::CastleKS;
+                const int rook_from_square = is_king_side ? from_square + Constants::KING_SIDE_ROOK_OFFSET
+                                                          : from_square - Constants::QUEEN_SIDE_ROOK_OFFSET;
+                const int rook_to_square = is_king_side ? to_square - 1 : to_square + 1;
+
+                next.MovePiece(moving_piece, from_square, to_square);
+                next.MovePiece(Bitboards::PieceIndex(moving_color, Enums::PieceType::Rook), rook_from_square, rook_to_square);
+                break;
+            }
+
+            default:
+                next.MovePiece(moving_piece, from_square, to_square);
+                break;
+        }
+
+        const bool is_pawn_move = Bitboards::PieceIndexType(moving_piece) == Enums::PieceType::Pawn;
+        next.halfmove_clock_ = (is_pawn_move || captured_piece != Bitboards::NO_PIECE) ? 0 : next.halfmove_clock_ + 1;
+        next.fullmove_number_ += (moving_color == Enums::Color::Dark) ? 1 : 0;
+
+        const int castling_rights = next.castling_rights_
+                                  & Bitboards::CastlingRightsKeptAfter(from_square)
+                                  & Bitboards::CastlingRightsKeptAfter(to_square);
+        next.zobrist_key_ ^= Zobrist::CastlingKey(next.castling_rights_) ^ Zobrist::CastlingKey(castling_rights);
+        next.castling_rights_ = static_cast<std::uint8_t>(castling_rights);
+
+        next.en_passant_square_ = static_cast<std::int8_t>((move_type == Enums::MoveType::DoublePawn)
+                                                         ? (from_square + to_square) / 2
+                                                         : Bitboards::NO_SQUARE);
+
+        next.side_to_move_ ^= 1;
+        next.zobrist_key_ ^= Zobrist::SideKey();
+
+        next.zobrist_key_ ^= next.GetEnPassantZobristKey();
+
+        return next;
+    }
+
+    void PositionState::TogglePiece(int piece_index, int square)
+    {
+        const Bitboard square_bb = Bitboards::SquareBB(square);
+        const Enums::Color color = Bitboards::PieceIndexColor(piece_index);
+
+        this->piece_bitboards_[piece_index] ^= square_bb;
+        this->color_bitboards_[Bitboards::ColorIndex(color)] ^= square_bb;
+        this->zobrist_key_ ^= Zobrist::PieceKey(color, Bitboards::PieceIndexType(piece_index), square);
+
+        this->squares_[square] = static_cast<std::uint8_t>((this->piece_bitboards_[piece_index] & square_bb) ? piece_index : Bitboards::NO_PIECE);
+    }
+
+    void PositionState::MovePiece(int piece_index, int from_square, int to_square)
+    {
+        TogglePiece(piece_index, from_square);
+        TogglePiece(piece_index, to_square);
+    }
+
+    // Only hash the en passant target if a pawn of the side to move stands ready to capture on it
+    ZobristKey PositionState::GetEnPassantZobristKey() const
+    {
+        if (this->en_passant_square_ == Bitboards::NO_SQUARE)
+        {
+            return 0;
+        }
+
+        const Enums::Color side_to_move = GetSideToMove();
+        const Enums::Color opponent_color = (side_to_move == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+        const Bitboard capturers = Attacks::PawnAttacks(opponent_color, this->en_passant_square_)
+                                 & GetPieceBitboard(side_to_move, Enums::PieceType::Pawn);
+
+        return capturers ? Zobrist::EnPassantKey(this->en_passant_square_ % Constants::BOARD_SIZE) : 0;
+    }
+
+    int PositionState::GetPieceAt(int square) const
+    {
+        return this->squares_[square];
+    }
+
+    Bitboard PositionState::GetPieceBitboard(Enums::Color color, Enums::PieceType piece_type) const
+    {
+        return this->piece_bitboards_[Bitboards::PieceIndex(color, piece_type)];
+    }
+
+    Bitboard PositionState::GetColorBitboard(Enums::Color color) const
+    {
+        return this->color_bitboards_[Bitboards::ColorIndex(color)];
+    }
+
+    Bitboard PositionState::GetOccupiedBitboard() const
+    {
+        return this->color_bitboards_[0] | this->color_bitboards_[1];
+    }
+
+    Enums::Color PositionState::GetSideToMove() const
+    {
+        return (this->side_to_move_ == 0) ? Enums::Color::Light : Enums::Color::Dark;
+    }
+
+    int PositionState::GetCastlingRights() const
+    {
+        return this->castling_rights_;
+    }
+
+    int PositionState::GetEnPassantSquare() const
+    {
+        return this->en_passant_square_;
+    }
+
+    int PositionState::GetHalfmoveClock() const
+    {
+        return this->halfmove_clock_;
+    }
+
+    int PositionState::GetFullmoveNumber() const
+    {
+        return this->fullmove_number_;
+    }
+
+    ZobristKey PositionState::GetZobristKey() const
+    {
+        return this->zobrist_key_;
+    }
+} // namespace GameLogic
@@ -0,0 +1,179 @@
+#include "game_logic/base/san.hpp"
+#include "game_logic/base/attacks.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
+#include "game_logic/base/move_record.hpp"
+#include "game_logic/validator/move_validator.hpp"
+
+#include "game_logic/enums.hpp"
+#include "game_logic/constants.hpp"
+
+#include <cstddef>
+
+namespace GameLogic
+{
+    namespace San
+    {
+        namespace
+        {
+            char PieceLetter(Enums::PieceType piece_type)
+            {
+                switch (piece_type)
+                {
+                    case (Enums::PieceType::Knight):
+                        return 'N';
+                    case (Enums::PieceType::Bishop):
+                        return 'B';
+                    case (Enums::PieceType::Rook):
+                        return 'R';
+                    case (Enums::PieceType::Queen):
+                        return 'Q';
+                    case (Enums::PieceType::King):
+                        return 'K';
+                    default:
+                        return '\0';
+                }
+            }
+
+            char FileLetter(int square)
+            {
+                return static_cast<char>('a' + square % Constants::BOARD_SIZE);
+            }
+
+            // Row 0 is the 8th rank
+            char RankDigit(int square)
+            {
+                return static_cast<char>('8' - square / Constants::BOARD_SIZE);
+            }
+
+            Enums::PieceType GetPieceTypeAt(const Board &board, Enums::Color color, int square)
+            {
+                for (Enums::PieceType piece_type : Constants::AllPieceType)
+                {
+                    if (Bitboards::Contains(board.GetPieceBitboard(color, piece_type), square))
+                    {
+                        return piece_type;
+                    }
+                }
+                return Enums::PieceType::None;
+            }
+        } // namespace
+
+        std::size_t WriteSanMove(Board &board, const Move &move, char *buffer)
+        {
+            char *out = buffer;
+
+            const Enums::MoveType move_type = move.GetMoveType();
+            if (move_type == Enums::MoveType::CastleKS || move_type == Enums::MoveType::CastleQS)
+            {
+                const char *castle = (move_type == Enums::MoveType::CastleKS) ? "O-O" : "O-O-O";
+                while (*castle != '\0')
+                {
+                    *out++ = *castle++;
+                }
+                return static_cast<std::size_t>(out - buffer);
+            }
+
+            const Enums::Color color = board.GetSideToMove();
+            const int from_square = move.GetFromSquare();
+            const int to_square = move.GetToSquare();
+            const Enums::PieceType piece_type = GetPieceTypeAt(board, color, from_square);
+            const bool is_capture = Bitboards::Contains(board.GetOccupiedBitboard(), to_square)
+                                 || move_type == Enums::MoveType::EnPassant;
+
+            if (piece_type == Enums::PieceType::Pawn)
+            {
+                // A pawn capture names the file it came from
+                if (is_capture)
+                {
+                    *out++ = FileLetter(from_square);
+                    *out++ = 'x';
+                }
+            }
+            else
+            {
+                *out++ = PieceLetter(piece_type);
+
+                // The other pieces of this type that attack the destination, and could legally move there
+                Bitboard rivals = Attacks::PieceAttacks(piece_type, to_square, board.GetOccupiedBitboard())
+                                & board.GetPieceBitboard(color, piece_type)
+                                & ~Bitboards::SquareBB(from_square);
+
+                bool has_rival = false;
+                bool shares_file = false;
+                bool shares_rank = false;
+
+                while (rivals)
+                {
+                    const int rival_square = Bitboards::PopLowestSquare(rivals);
+                    if (!MoveValidator::IsKingSafeAfterMove(Move(Enums::MoveType::Normal, rival_square, to_square), color, board))
+                    {
+                        continue;
+                    }
+
+                    has_rival = true;
+                    shares_file = shares_file || (rival_square % Constants::BOARD_SIZE == from_square % Constants::BOARD_SIZE);
+                    shares_rank = shares_rank || (rival_square / Constants::BOARD_SIZE == from_square / Constants::BOARD_SIZE);
+                }
+
+                // The file if it tells the pieces apart, else the rank, else both
+                if (has_rival && (!shares_file || shares_rank))
+                {
+                    *out++ = FileLetter(from_square);
+                }
+                if (has_rival && shares_file)
+                {
+                    *out++ = RankDigit(from_square);
+                }
+
+                if (is_capture)
+                {
+                    *out++ = 'x';
+                }
+            }
+
+            *out++ = FileLetter(to_square);
+            *out++ = RankDigit(to_square);
+
+            if (move_type == Enums::MoveType::PawnPromotion)
+            {
+                // No promotion piece chosen yet means a queen, as in Board::MakeMove
+                const Enums::PieceType promotion_piece_type = move.GetPromotionPieceType();
+                *out++ = '=';
+                *out++ = PieceLetter((promotion_piece_type == Enums::PieceType::None) ? Enums::PieceType::Queen : promotion_piece_type);
+            }
+
+            return static_cast<std::size_t>(out - buffer);
+        }
+
+        char GetCheckMark(Board &board)
+        {
+            const Enums::Color color = board.GetSideToMove();
+            if (!MoveValidator::IsKingInCheck(color, board))
+            {
+                return '\0';
+            }
+
+            MoveList legal_moves;
+            MoveValidator::GetAllLegalMovesForPlayer(color, board, nullptr, legal_moves);
+            return legal_moves.Empty() ? '#' : '+';
+        }
+
+        std::size_t WriteSan(Board &board, const Move &move, char *buffer)
+        {
+            std::size_t length = WriteSanMove(board, move, buffer);
+
+            const MoveRecord record = board.MakeMove(move);
+            const char check_mark = GetCheckMark(board);
+            board.UnmakeMove(record);
+
+            if (check_mark != '\0')
+            {
+                buffer[length++] = check_mark;
+            }
+            return length;
+        }
+    } // namespace San
+} // namespace GameLogic
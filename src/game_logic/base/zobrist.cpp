@@ -0,0 +1,95 @@
+#include "game_logic/base/zobrist.hpp"
+#include "game_logic/base/bitboard.hpp"
+
+#include "game_logic/enums.hpp"
+#include "game_logic/constants.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace GameLogic
+{
+    namespace Zobrist
+    {
+        namespace
+        {
+            struct ZobristKeys
+            {
+                std::array<std::array<ZobristKey, Bitboards::SQUARE_COUNT>, Bitboards::PIECE_COUNT> piece{};
+                std::array<ZobristKey, Constants::CASTLE_ALL + 1> castling{};
+                std::array<ZobristKey, Constants::BOARD_SIZE> en_passant{};
+                ZobristKey side = 0;
+            };
+
+            // SplitMix64, a fixed seed keeps the keys identical across runs and builds
+            constexpr ZobristKey NextKey(std::uint64_t &state)
+            {
+                std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            }
+
+            constexpr ZobristKeys GenerateKeys()
+            {
+                ZobristKeys keys{};
+                std::uint64_t state = 0x5EED5EED5EED5EEDULL;
+
+                for (auto &piece_keys : keys.piece)
+                {
+                    for (ZobristKey &key : piece_keys)
+                    {
+                        key = NextKey(state);
+                    }
+                }
+
+                // Each castling right gets its own key, a mask hashes to the XOR of its rights
+                std::array<ZobristKey, 4> right_keys{};
+                for (ZobristKey &key : right_keys)
+                {
+                    key = NextKey(state);
+                }
+                for (int rights = 0; rights <= Constants::CASTLE_ALL; rights++)
+                {
+                    for (int bit = 0; bit < 4; bit++)
+                    {
+                        if (rights & (1 << bit))
+                        {
+                            keys.castling[rights] ^= right_keys[bit];
+                        }
+                    }
+                }
+
+                for (ZobristKey &key : keys.en_passant)
+                {
+                    key = NextKey(state);
+                }
+
+                keys.side = NextKey(state);
+                return keys;
+            }
+
+            constexpr ZobristKeys KEYS = GenerateKeys();
+        } // namespace
+
+        ZobristKey PieceKey(Enums::Color color, Enums::PieceType piece_type, int square)
+        {
+            return KEYS.piece[Bitboards::PieceIndex(color, piece_type)][square];
+        }
+
+        ZobristKey CastlingKey(int castling_rights)
+        {
+            return KEYS.castling[castling_rights];
+        }
+
+        ZobristKey EnPassantKey(int col)
+        {
+            return KEYS.en_passant[col];
+        }
+
+        ZobristKey SideKey()
+        {
+            return KEYS.side;
+        }
+    } // namespace Zobrist
+} // namespace GameLogic
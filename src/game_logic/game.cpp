@@ -1,37 +1,143 @@
 #include "game_logic/game.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/fen.hpp"
 #include "game_logic/base/player.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/position.hpp"
+#include "game_logic/base/position_state.hpp"
 #include "game_logic/base/game_result.hpp"
+#include "game_logic/base/san.hpp"
 #include "game_logic/validator/move_validator.hpp"
+#include "game_logic/trace/trace.hpp"
 #include "game_logic/enums.hpp"
 
-#include <iostream>
-#include <sstream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 
 namespace GameLogic
 {
+    namespace
+    {
+        /** @brief Room for the tag pairs (a FEN tag included), the result and the terminating null of a PGN. */
+        constexpr std::size_t PGN_HEADER_LENGTH = 512;
+
+        /** @brief Room for one half move of PGN movetext: a separator, a move number and a SAN move. */
+        constexpr std::size_t PGN_PLY_LENGTH = 2 + 6 + San::MAX_SAN_LENGTH;
+
+        /** @brief Movetext lines are wrapped before reaching this length. */
+        constexpr std::size_t PGN_LINE_LENGTH = 80;
+
+        char *AppendText(char *out, const char *text)
+        {
+            while (*text != '\0')
+            {
+                *out++ = *text++;
+            }
+            return out;
+        }
+
+        /** @brief Writes a full move number followed by "." for Light or "..." for Dark, returns the length. */
+        std::size_t WriteMoveNumber(int fullmove_number, bool is_dark, char *buffer)
+        {
+            char digits[12];
+            std::size_t digit_count = 0;
+            do
+            {
+                digits[digit_count++] = static_cast<char>('0' + fullmove_number % 10);
+                fullmove_number /= 10;
+            } while (fullmove_number > 0);
+
+            std::size_t length = 0;
+            while (digit_count > 0)
+            {
+                buffer[length++] = digits[--digit_count];
+            }
+
+            const char *dots = is_dark ? "..." : ".";
+            while (*dots != '\0')
+            {
+                buffer[length++] = *dots++;
+            }
+            return length;
+        }
+    } // namespace
+
     // Construct a Game object
     Game::Game()
         : board_(),
         player_light_(Enums::Color::Light),
         player_dark_(Enums::Color::Dark),
-        current_player_color_(Enums::Color::Light){};
+        current_player_color_(Enums::Color::Light),
+        fifty_move_counter_(0),
+        full_move_counter_(1),
+        position_history_{board_.GetZobristKey()},
+        start_position_(board_),
+        legal_moves_key_(0),
+        legal_moves_cached_(false){};
+
+    // Generate the legal moves of the current player once per position
+    const MoveList &Game::GetLegalMoves()
+    {
+        const ZobristKey position_key = this->board_.GetZobristKey();
+
+        if (!this->legal_moves_cached_ || this->legal_moves_key_ != position_key)
+        {
+            this->legal_moves_.Clear();
+            MoveValidator::GetAllLegalMovesForPlayer(this->current_player_color_, this->board_, GetLastMove(), this->legal_moves_);
+            this->legal_moves_key_ = position_key;
+            this->legal_moves_cached_ = true;
+        }
+        return this->legal_moves_;
+    }
 
     // Get all legal moves a piece can make at the given position
     std::vector<Move> Game::GetLegalMovesAtPosition(const Position &position)
     {
-        const Move *last_move = GetLastMove();
-        // Get all legal moves at the given position for the board object
-        return MoveValidator::GetLegalMovesAtPosition(position, this->current_player_color_, this->board_, last_move);
+        std::vector<Move> legal_moves;
+
+        // No piece can move from a position off the board
+        if (!this->board_.IsPositionOnBoard(position))
+        {
+            return legal_moves;
+        }
+
+        const int from_square = Bitboards::ToSquare(position);
+        for (const Move &move : GetLegalMoves())
+        {
+            if (move.GetFromSquare() == from_square)
+            {
+                legal_moves.push_back(move);
+            }
+        }
+        return legal_moves;
     }
 
     // Get all legal move a player can make
     std::vector<Move> Game::GetAllLegalMovesForPlayer(Enums::Color player_color)
     {
+        MoveList legal_moves;
+        GetAllLegalMovesForPlayer(player_color, legal_moves);
+        return legal_moves.ToVector();
+    }
+
+    // Append all legal move a player can make without allocating, the current player's come from the cache
+    void Game::GetAllLegalMovesForPlayer(Enums::Color player_color, MoveList &legal_moves)
+    {
+        if (player_color == this->current_player_color_)
+        {
+            for (const Move &move : GetLegalMoves())
+            {
+                legal_moves.PushBack(move);
+            }
+            return;
+        }
+
         const Move *last_move = GetLastMove();
-        return MoveValidator::GetAllLegalMovesForPlayer(player_color, this->board_, last_move);
+        MoveValidator::GetAllLegalMovesForPlayer(player_color, this->board_, last_move, legal_moves);
     }
 
     // Returns a immutable map of key: position to value: pieces
@@ -49,23 +155,20 @@ namespace GameLogic
     // Execute the move that is given by the player
     bool Game::ExecuteMove(const Move& move)
     {
-        // Check if the move is legal
-        bool is_legal_move = MoveValidator::IsLegalMove(move, this->current_player_color_, this->board_);
+        // Check if the move is legal, the move list of this position is usually cached already
+        bool is_legal_move = GetLegalMoves().Contains(move);
         if (is_legal_move == false)
         {
             return false;
         }
 
-        // For debugging purposes
-        std::cout << Constants::GET_MOVE_TYPE_REPR(move.GetMoveType()) << std::endl;
-
         // Check if move captures a piece or is a pawn move
         bool is_capture_move = MoveValidator::IsCaptureMove(move, this->board_);
         bool is_pawn_move = MoveValidator::IsPawnMove(move, this->board_);
 
         // // Execute the move with move executor
         // MoveExecutor::ExecuteMove(move, this->current_player_color_, this->board_);
-        MoveRecord record = std::move(this->board_.MakeMove(move));
+        MoveRecord record = this->board_.MakeMove(move);
         record.SetPrevFiftyMoveCounter(this->fifty_move_counter_);
 
         // Update 50 move rule counter
@@ -80,11 +183,10 @@ namespace GameLogic
         {
             this->full_move_counter_++;
         }
-        position_history_.push_back(GenerateFenPiecePlacement());
+        position_history_.push_back(this->board_.GetZobristKey());
 
         UpdateGameState();
-        std::cout << "FiftyMoveCounter: " << this->fifty_move_counter_ << "\n";
-        this->board_.DisplayBoard();
+        Trace::Emit<Trace::Level::Debug>("move_executed", move, this->fifty_move_counter_, this->board_.GetZobristKey());
 
         return true;
     }
@@ -108,15 +210,13 @@ namespace GameLogic
             {
                 this->full_move_counter_--;
             }
-            // Remove the last position from history
-            if (!position_history_.empty())
+            // Remove the last position from history, the start position always stays
+            if (position_history_.size() > 1)
             {
                 position_history_.pop_back();
             }
 
-            std::cout << "Undo\n";
-            std::cout << "FiftyMoveCounter: " << this->fifty_move_counter_ << "\n";
-            this->board_.DisplayBoard();
+            Trace::Emit<Trace::Level::Debug>("move_undone", record.ReadMoveMade(), this->fifty_move_counter_, this->board_.GetZobristKey());
 
             UpdateGameState();
         }
@@ -130,11 +230,14 @@ namespace GameLogic
             this->redo_history_.pop_back();
 
             const Move &move_to_redo = old_record.ReadMoveMade();
-            MoveRecord new_record = std::move(this->board_.MakeMove(move_to_redo));
-            new_record.SetPrevFiftyMoveCounter(this->fifty_move_counter_);
 
+            // Check the move before it is made, afterwards the moved piece stands on the destination
             bool is_pawn_move = MoveValidator::IsPawnMove(move_to_redo, this->board_);
             bool is_capture_move = MoveValidator::IsCaptureMove(move_to_redo, this->board_);
+
+            MoveRecord new_record = this->board_.MakeMove(move_to_redo);
+            new_record.SetPrevFiftyMoveCounter(this->fifty_move_counter_);
+
             UpdateFiftyMoveCounter(is_pawn_move, is_capture_move);
 
             this->undo_history_.push_back(std::move(new_record));
@@ -145,11 +248,9 @@ namespace GameLogic
                 this->full_move_counter_++;
             }
             // Add position to history
-            position_history_.push_back(GenerateFenPiecePlacement());
+            position_history_.push_back(this->board_.GetZobristKey());
 
-            std::cout << "Redo\n";
-            std::cout << "FiftyMoveCounter: " << this->fifty_move_counter_ << "\n";
-            this->board_.DisplayBoard();
+            Trace::Emit<Trace::Level::Debug>("move_redone", move_to_redo, this->fifty_move_counter_, this->board_.GetZobristKey());
 
             UpdateGameState();
         }
@@ -201,7 +302,7 @@ namespace GameLogic
         }
 
         // Check if the current player has any legal moves
-        if (GetAllLegalMovesForPlayer(this->current_player_color_).empty())
+        if (GetLegalMoves().Empty())
         {
             // Checkmate if current player has no legal moves and their king is in check
             if (MoveValidator::IsKingInCheck(this->current_player_color_, this->board_))
@@ -216,9 +317,11 @@ namespace GameLogic
         }
     }
 
+    // Every caller has just executed, undone or redone a move, so the cached legal moves are stale
     void Game::SwitchPlayerTurn()
     {
         this->current_player_color_ = GetOpponentPlayer().GetColor();
+        this->legal_moves_cached_ = false;
     }
 
     bool Game::CanUndo() const
@@ -238,7 +341,10 @@ namespace GameLogic
         undo_history_.clear();
         redo_history_.clear();
         fifty_move_counter_ = 0;
-        position_history_.clear();
+        full_move_counter_ = 1;
+        position_history_.assign(1, board_.GetZobristKey());
+        start_position_ = PositionState(board_);
+        legal_moves_cached_ = false;
         result_.Reset();
     }
 
@@ -261,153 +367,155 @@ namespace GameLogic
 
     std::string Game::GenerateFen() const
     {
-        std::stringstream fen_ss;
+        char fen[Fen::MAX_FEN_LENGTH];
+        const std::size_t fen_length = GenerateFen(fen, sizeof(fen));
 
-        fen_ss << GenerateFenPiecePlacement() << ' ';
-        fen_ss << GenerateFenActiveColor() << ' ';
-        fen_ss << GenerateFenCastlingRights() << ' ';
-        fen_ss << GenerateFenEnPassantSquare() << ' ';
-        fen_ss << GenerateFenHalfmoveClock() << ' ';
-        fen_ss << GenerateFenFullmoveNumber();
-
-        return fen_ss.str();
+        return std::string(fen, fen_length);
     }
 
-    std::string Game::GenerateFenPiecePlacement() const
+    // The side to move, castling rights and en passant target are kept up to date by the Board
+    std::size_t Game::GenerateFen(char *buffer, std::size_t buffer_size) const
     {
-        std::string piece_placement;
-
-        for (int row = 0; row < Constants::BOARD_SIZE; row++)
-        {
-            int empty_squares = 0;
+        return Fen::WriteFen(this->board_, Fen::FenClocks{this->fifty_move_counter_, this->full_move_counter_}, buffer, buffer_size);
+    }
 
-            for (int col = 0; col < Constants::BOARD_SIZE; col++)
-            {
-                const Piece *piece = this->board_.GetPieceAt(Position{row, col});
-
-                if (piece == nullptr)
-                {
-                    empty_squares++;
-                }
-                else
-                {
-                    if (empty_squares > 0)
-                    {
-                        piece_placement += std::to_string(empty_squares);
-                        empty_squares = 0;
-                    }
-
-                    piece_placement += Constants::GET_PIECE_REPR(piece->GetColor(), piece->GetPieceType());
-                }
-            }
+    void Game::LoadFen(const std::string &fen)
+    {
+        const Fen::FenClocks clocks = Fen::LoadFen(fen, this->board_);
 
-            if (empty_squares > 0)
-            {
-                piece_placement += std::to_string(empty_squares);
-            }
-            if (row < Constants::BOARD_SIZE - 1)
-            {
-                piece_placement += '/';
-            }
-        }
+        this->current_player_color_ = this->board_.GetSideToMove();
+        this->undo_history_.clear();
+        this->redo_history_.clear();
+        this->fifty_move_counter_ = clocks.halfmove_clock;
+        this->full_move_counter_ = clocks.fullmove_number;
+        this->position_history_.assign(1, this->board_.GetZobristKey());
+        this->start_position_ = PositionState(this->board_, clocks.halfmove_clock, clocks.fullmove_number);
+        this->legal_moves_cached_ = false;
+        this->result_.Reset();
 
-        return piece_placement;
+        UpdateGameState();
     }
 
-    std::string Game::GenerateFenActiveColor() const
+    std::size_t Game::GetPgnBufferSize() const
     {
-        return std::string(1, Constants::GET_COLOR_REPR(this->current_player_color_));
+        return PGN_HEADER_LENGTH + PGN_PLY_LENGTH * this->undo_history_.size();
     }
 
-    std::string Game::GenerateFenCastlingRights() const
+    // Replay the undo history from the start position on a scratch Board, writing each move before making it
+    std::size_t Game::ExportPgn(char *buffer, std::size_t buffer_size) const
     {
-        std::string castling_rights = "";
+        if (buffer_size < GetPgnBufferSize())
+        {
+            throw std::length_error("PGN buffer must hold at least GetPgnBufferSize() characters");
+        }
 
-        const Piece *white_king = this->board_.GetPieceAt(Position{7, 4});
-        if (
-            white_king
-        &&  white_king->GetPieceType() == Enums::PieceType::King
-        &&  white_king->GetColor() == Enums::Color::Light
-        &&  white_king->HasMoved() == false)
+        char *out = buffer;
+        const char *result = this->result_.GetPgnResult();
+
+        out = AppendText(out, "[Event \"?\"]\n[Site \"?\"]\n[Date \"????.??.??\"]\n[Round \"?\"]\n"
+                              "[White \"?\"]\n[Black \"?\"]\n[Result \"");
+        out = AppendText(out, result);
+        out = AppendText(out, "\"]\n");
+
+        Board board;
+        board.LoadPositionState(this->start_position_);
+
+        if (!StartsFromStandardPosition())
+        {
+            const Fen::FenClocks clocks{this->start_position_.GetHalfmoveClock(), this->start_position_.GetFullmoveNumber()};
+            out = AppendText(out, "[SetUp \"1\"]\n[FEN \"");
+            out += Fen::WriteFen(board, clocks, out, Fen::MAX_FEN_LENGTH);
+            out = AppendText(out, "\"]\n");
+        }
+        *out++ = '\n';
+
+        // Every token is written after a space, or a new line once the line would grow too long
+        std::size_t line_length = 0;
+        auto append_token = [&out, &line_length](const char *token, std::size_t token_length)
         {
-            const Piece *white_rook_ks = this->board_.GetPieceAt(Position{7, 7});
-            if (
-                white_rook_ks
-            &&  white_rook_ks->GetPieceType() == Enums::PieceType::Rook
-            &&  white_rook_ks->GetColor() == Enums::Color::Light
-            &&  white_rook_ks->HasMoved() == false)
+            if (line_length > 0)
             {
-                castling_rights += 'K';
+                const bool wrap = line_length + 1 + token_length >= PGN_LINE_LENGTH;
+                *out++ = wrap ? '\n' : ' ';
+                line_length = wrap ? 0 : line_length + 1;
             }
-            const Piece *white_rook_qs = this->board_.GetPieceAt(Position{7, 0});
-            if (
-                white_rook_qs
-            &&  white_rook_qs->GetPieceType() == Enums::PieceType::Rook
-            &&  white_rook_qs->GetColor() == Enums::Color::Light
-            &&  white_rook_qs->HasMoved() == false)
+            for (std::size_t index = 0; index < token_length; index++)
             {
-                castling_rights += 'Q';
+                *out++ = token[index];
             }
-        }
+            line_length += token_length;
+        };
 
+        char token[San::MAX_SAN_LENGTH + 8];
+        int fullmove_number = this->start_position_.GetFullmoveNumber();
+        bool is_first_move = true;
 
-        const Piece *black_king = this->board_.GetPieceAt(Position{0, 4});
-        if (
-            black_king
-        &&  black_king->GetPieceType() == Enums::PieceType::King
-        &&  black_king->GetColor() == Enums::Color::Dark
-        &&  black_king->HasMoved() == false)
+        for (const MoveRecord &record : this->undo_history_)
         {
-            const Piece *black_rook_ks = this->board_.GetPieceAt(Position{0, 7});
-            if (
-                black_rook_ks
-            &&  black_rook_ks->GetPieceType() == Enums::PieceType::Rook
-            &&  black_rook_ks->GetColor() == Enums::Color::Dark
-            &&  black_rook_ks->HasMoved() == false)
+            const bool is_dark = board.GetSideToMove() == Enums::Color::Dark;
+
+            // Light's moves are numbered, and Dark's first move if Dark moves first
+            if (!is_dark || is_first_move)
             {
-                castling_rights += 'k';
+                append_token(token, WriteMoveNumber(fullmove_number, is_dark, token));
             }
-            const Piece *black_rook_qs = this->board_.GetPieceAt(Position{0, 0});
-            if (
-                black_rook_qs
-            &&  black_rook_qs->GetPieceType() == Enums::PieceType::Rook
-            &&  black_rook_qs->GetColor() == Enums::Color::Dark
-            &&  black_rook_qs->HasMoved() == false)
+            is_first_move = false;
+
+            const Move &move = record.ReadMoveMade();
+            std::size_t san_length = San::WriteSanMove(board, move, token);
+            board.MakeMove(move);
+
+            const char check_mark = San::GetCheckMark(board);
+            if (check_mark != '\0')
             {
-                castling_rights += 'q';
+                token[san_length++] = check_mark;
             }
+            append_token(token, san_length);
+
+            fullmove_number += is_dark ? 1 : 0;
+        }
+
+        std::size_t result_length = 0;
+        while (result[result_length] != '\0')
+        {
+            result_length++;
         }
+        append_token(result, result_length);
 
-        return castling_rights.empty() ? "-" : castling_rights;
+        *out++ = '\n';
+        *out = '\0';
+
+        return static_cast<std::size_t>(out - buffer);
     }
 
-    std::string Game::GenerateFenEnPassantSquare() const
+    const PositionState &Game::GetStartPosition() const
     {
-        const Move *last_move = GetLastMove();
+        return this->start_position_;
+    }
 
-        if (last_move != nullptr && last_move->GetMoveType() == Enums::MoveType::DoublePawn)
-        {
-            Position two_step_position = last_move->GetToPosition();
-            int one_step_row = (current_player_color_ == Enums::Color::Light)
-                ? two_step_position.GetRow() + 1
-                : two_step_position.GetRow() - 1;
-            int one_step_col = two_step_position.GetCol();
-            return  Position{one_step_row, one_step_col}.PositionToAlgebraic();
-        }
-        else
-        {
-            return "-";
-        }
+    // A new Board holds the standard position
+    bool Game::StartsFromStandardPosition() const
+    {
+        static const PositionState standard_position{Board()};
+
+        return this->start_position_.GetZobristKey() == standard_position.GetZobristKey()
+            && this->start_position_.GetHalfmoveClock() == standard_position.GetHalfmoveClock()
+            && this->start_position_.GetFullmoveNumber() == standard_position.GetFullmoveNumber();
     }
 
-    std::string Game::GenerateFenHalfmoveClock() const
+    const std::vector<MoveRecord> &Game::GetMoveHistory() const
     {
-        return std::to_string(this->fifty_move_counter_);
+        return this->undo_history_;
     }
 
-    std::string Game::GenerateFenFullmoveNumber() const
+    PositionState Game::GetPositionState() const
     {
-        return std::to_string(this->full_move_counter_);
+        return PositionState(this->board_, this->fifty_move_counter_, this->full_move_counter_);
+    }
+
+    const Board &Game::GetBoard() const
+    {
+        return this->board_;
     }
 
     const GameResult &Game::GetGameResult() const
@@ -417,90 +525,58 @@ namespace GameLogic
 
     bool Game::IsThreefoldRepetition() const
     {
-        if (position_history_.empty())
+        const int last_index = static_cast<int>(position_history_.size()) - 1;
+        if (last_index < 0)
         {
             return false;
         }
 
-        const std::string &current_position = position_history_.back();
-        return std::count(position_history_.begin(), position_history_.end(), current_position) >= 3;
-    }
-
-    bool Game::IsInsufficientMaterial() const
-    {
-        std::vector<Enums::PieceType> light_pieces;
-        std::vector<Enums::PieceType> dark_pieces;
-        std::vector<Enums::Color> light_bishop_colors;
-        std::vector<Enums::Color> dark_bishop_colors;
+        // A capture or pawn move can not be undone, so stop at the last one.
+        // Positions with the other side to move can not match, so step back two plies at a time.
+        const ZobristKey current_position = position_history_[last_index];
+        const int oldest_index = std::max(0, last_index - this->fifty_move_counter_);
+        int repetitions = 1;
 
-        // Collect all pieces
-        for (int row = 0; row < Constants::BOARD_SIZE; row++)
+        for (int index = last_index - 2; index >= oldest_index; index -= 2)
         {
-            for (int col = 0; col < Constants::BOARD_SIZE; col++)
+            if (position_history_[index] == current_position && ++repetitions >= 3)
             {
-                Position pos(row, col);
-                const Piece *piece = board_.GetPieceAt(pos);
-                if (piece)
-                {
-                    Enums::PieceType type = piece->GetPieceType();
-
-                    // Pawns, rooks, queens can always deliver checkmate
-                    if (type == Enums::PieceType::Pawn ||
-                        type == Enums::PieceType::Rook ||
-                        type == Enums::PieceType::Queen)
-                    {
-                        return false;
-                    }
-
-                    if (piece->GetColor() == Enums::Color::Light)
-                    {
-                        if (type != Enums::PieceType::King)
-                        {
-                            light_pieces.push_back(type);
-                            if (type == Enums::PieceType::Bishop)
-                            {
-                                light_bishop_colors.push_back(pos.GetSquareColor());
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (type != Enums::PieceType::King)
-                        {
-                            dark_pieces.push_back(type);
-                            if (type == Enums::PieceType::Bishop)
-                            {
-                                dark_bishop_colors.push_back(pos.GetSquareColor());
-                            }
-                        }
-                    }
-                }
+                return true;
             }
         }
+        return false;
+    }
+
+    // Compare the board's material signature (kings left out) against the drawn balances
+    bool Game::IsInsufficientMaterial() const
+    {
+        const std::uint64_t kings = Bitboards::MaterialSignature(Enums::Color::Light, Enums::PieceType::King)
+                                  + Bitboards::MaterialSignature(Enums::Color::Dark, Enums::PieceType::King);
+        const std::uint64_t material = this->board_.GetMaterialSignature() - kings;
 
         // King vs King
-        if (light_pieces.empty() && dark_pieces.empty())
+        if (material == 0)
         {
             return true;
         }
 
         // King + minor piece vs King
-        if ((light_pieces.empty() && dark_pieces.size() == 1
-        && (dark_pieces[0] == Enums::PieceType::Bishop || dark_pieces[0] == Enums::PieceType::Knight))
-        || (dark_pieces.empty() && light_pieces.size() == 1
-        && (light_pieces[0] == Enums::PieceType::Bishop || light_pieces[0] == Enums::PieceType::Knight)))
+        if (material == Bitboards::MaterialSignature(Enums::Color::Light, Enums::PieceType::Bishop)
+        ||  material == Bitboards::MaterialSignature(Enums::Color::Light, Enums::PieceType::Knight)
+        ||  material == Bitboards::MaterialSignature(Enums::Color::Dark, Enums::PieceType::Bishop)
+        ||  material == Bitboards::MaterialSignature(Enums::Color::Dark, Enums::PieceType::Knight))
         {
             return true;
         }
 
         // King + Bishop vs King + Bishop (same color bishops)
-        if (light_pieces.size() == 1 && dark_pieces.size() == 1 &&
-            light_pieces[0] == Enums::PieceType::Bishop &&
-            dark_pieces[0] == Enums::PieceType::Bishop &&
-            !light_bishop_colors.empty() && !dark_bishop_colors.empty() &&
-            light_bishop_colors[0] == dark_bishop_colors[0])
+        if (material == Bitboards::MaterialSignature(Enums::Color::Light, Enums::PieceType::Bishop)
+                      + Bitboards::MaterialSignature(Enums::Color::Dark, Enums::PieceType::Bishop))
         {
-            return true;
+            const Bitboard bishops = this->board_.GetPieceBitboard(Enums::Color::Light, Enums::PieceType::Bishop)
+                                   | this->board_.GetPieceBitboard(Enums::Color::Dark, Enums::PieceType::Bishop);
+            return (bishops & Bitboards::LIGHT_SQUARES) == Bitboards::EMPTY
+                || (bishops & ~Bitboards::LIGHT_SQUARES) == Bitboards::EMPTY;
         }
 
         return false;
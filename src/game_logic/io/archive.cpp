@@ -0,0 +1,428 @@
+#include "game_logic/io/archive.hpp"
+#include "game_logic/game.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/fen.hpp"
+#include "game_logic/base/game_result.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
+#include "game_logic/base/move_record.hpp"
+#include "game_logic/base/position_state.hpp"
+#include "game_logic/replay/replay.hpp"
+#include "game_logic/validator/move_validator.hpp"
+
+#include "game_logic/enums.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GameLogic
+{
+    namespace Archive
+    {
+        namespace
+        {
+            /** @brief The promotion pieces in the order they are sorted in. */
+            constexpr std::array<Enums::PieceType, 4> PROMOTION_ORDER =
+            {
+                Enums::PieceType::Queen,
+                Enums::PieceType::Rook,
+                Enums::PieceType::Bishop,
+                Enums::PieceType::Knight,
+            };
+
+            /** @brief The most plies a game can hold, its ply count is stored in 16 bits. */
+            constexpr std::size_t MAX_PLY_COUNT = 0xFFFF;
+
+            /** @brief The size of a game's own header: ply count, result and FEN length. */
+            constexpr std::size_t GAME_HEADER_SIZE = 4;
+
+            // The sort key of a move, the promotion piece in the lowest two bits
+            int GetSquaresKey(const Move &move)
+            {
+                return (move.GetFromSquare() * 64 + move.GetToSquare()) << 2;
+            }
+
+            int GetPromotionIndex(const Move &move)
+            {
+                const Enums::PieceType promotion_piece_type = move.GetPromotionPieceType();
+                for (int index = 0; index < static_cast<int>(PROMOTION_ORDER.size()); index++)
+                {
+                    if (PROMOTION_ORDER[index] == promotion_piece_type)
+                    {
+                        return index;
+                    }
+                }
+
+                // No promotion piece chosen yet means a queen
+                return 0;
+            }
+
+            // The state in the low four bits, the winner (0 None, 1 Light, 2 Dark) in the high four
+            std::uint8_t EncodeResult(const GameResult &result)
+            {
+                const Enums::Color winner = result.GetWinnerColor();
+                const int winner_code = (winner == Enums::Color::Light) ? 1 : (winner == Enums::Color::Dark) ? 2 : 0;
+                return static_cast<std::uint8_t>(static_cast<int>(result.GetGameState()) | (winner_code << 4));
+            }
+
+            void AppendInteger(std::vector<char> &bytes, std::uint64_t value, std::size_t size)
+            {
+                for (std::size_t byte = 0; byte < size; byte++)
+                {
+                    bytes.push_back(static_cast<char>((value >> (8 * byte)) & 0xFF));
+                }
+            }
+
+            std::uint64_t ReadInteger(std::string_view data, std::size_t offset, std::size_t size)
+            {
+                std::uint64_t value = 0;
+                for (std::size_t byte = 0; byte < size; byte++)
+                {
+                    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[offset + byte])) << (8 * byte);
+                }
+                return value;
+            }
+        } // namespace
+
+        // The index is the number of (move, promotion piece) pairs that sort before the move
+        std::uint8_t EncodeMove(const Move &move, const MoveList &legal_moves)
+        {
+            const int squares_key = GetSquaresKey(move);
+            const bool is_promotion = move.GetMoveType() == Enums::MoveType::PawnPromotion;
+            const int key = squares_key | (is_promotion ? GetPromotionIndex(move) : 0);
+
+            int index = 0;
+            bool is_found = false;
+
+            for (const Move &legal_move : legal_moves)
+            {
+                const int legal_key = GetSquaresKey(legal_move);
+                const int option_count = (legal_move.GetMoveType() == Enums::MoveType::PawnPromotion)
+                                       ? static_cast<int>(PROMOTION_ORDER.size())
+                                       : 1;
+
+                index += std::clamp(key - legal_key, 0, option_count);
+                is_found = is_found || legal_key == squares_key;
+            }
+
+            if (!is_found)
+            {
+                throw std::invalid_argument("Move is not legal in the position being archived");
+            }
+            return static_cast<std::uint8_t>(index);
+        }
+
+        bool DecodeMove(std::uint8_t index, const MoveList &legal_moves, Move &move)
+        {
+            // A position has at most 218 legal moves counting each promotion piece, they fit one byte
+            std::array<std::uint16_t, 256> keys;
+            std::size_t key_count = 0;
+
+            for (const Move &legal_move : legal_moves)
+            {
+                const int legal_key = GetSquaresKey(legal_move);
+                const int option_count = (legal_move.GetMoveType() == Enums::MoveType::PawnPromotion)
+                                       ? static_cast<int>(PROMOTION_ORDER.size())
+                                       : 1;
+
+                for (int option = 0; option < option_count && key_count < keys.size(); option++)
+                {
+                    keys[key_count++] = static_cast<std::uint16_t>(legal_key | option);
+                }
+            }
+
+            if (index >= key_count)
+            {
+                return false;
+            }
+
+            std::nth_element(keys.begin(), keys.begin() + index, keys.begin() + key_count);
+            const int key = keys[index];
+
+            for (const Move &legal_move : legal_moves)
+            {
+                if (GetSquaresKey(legal_move) == (key & ~3))
+                {
+                    move = legal_move;
+                    if (move.GetMoveType() == Enums::MoveType::PawnPromotion)
+                    {
+                        move.SetPromotionPieceType(PROMOTION_ORDER[key & 3]);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        ArchiveWriter::ArchiveWriter(std::ostream &stream)
+            : stream_(stream),
+            offset_(0),
+            is_finished_(false)
+        {
+            std::vector<char> header(ARCHIVE_MAGIC, ARCHIVE_MAGIC + sizeof(ARCHIVE_MAGIC));
+            AppendInteger(header, ARCHIVE_VERSION, 2);
+            AppendInteger(header, 0, 2);
+
+            this->stream_.write(header.data(), static_cast<std::streamsize>(header.size()));
+            this->offset_ = header.size();
+        }
+
+        ArchiveWriter::~ArchiveWriter()
+        {
+            if (!this->is_finished_)
+            {
+                try
+                {
+                    Finish();
+                }
+                catch (const std::exception &)
+                {
+                    // A destructor must not throw, call Finish to see the error
+                }
+            }
+        }
+
+        // Replay the history on the scratch Board, each move is indexed in the legal moves of the position before it
+        void ArchiveWriter::WriteGame(const Game &game)
+        {
+            if (this->is_finished_)
+            {
+                throw std::logic_error("Cannot write a game to a finished archive");
+            }
+
+            const std::vector<MoveRecord> &history = game.GetMoveHistory();
+            if (history.size() > MAX_PLY_COUNT)
+            {
+                throw std::length_error("An archived game holds at most 65535 plies");
+            }
+
+            const PositionState &start_position = game.GetStartPosition();
+            this->board_.LoadPositionState(start_position);
+
+            this->game_bytes_.clear();
+            AppendInteger(this->game_bytes_, history.size(), 2);
+            this->game_bytes_.push_back(static_cast<char>(EncodeResult(game.GetGameResult())));
+
+            if (game.StartsFromStandardPosition())
+            {
+                this->game_bytes_.push_back(0);
+            }
+            else
+            {
+                char fen[Fen::MAX_FEN_LENGTH];
+                const Fen::FenClocks clocks{start_position.GetHalfmoveClock(), start_position.GetFullmoveNumber()};
+                const std::size_t fen_length = Fen::WriteFen(this->board_, clocks, fen, sizeof(fen));
+
+                this->game_bytes_.push_back(static_cast<char>(fen_length));
+                this->game_bytes_.insert(this->game_bytes_.end(), fen, fen + fen_length);
+            }
+
+            for (const MoveRecord &record : history)
+            {
+                const Move &move = record.ReadMoveMade();
+
+                this->legal_moves_.Clear();
+                MoveValidator::GetAllLegalMovesForPlayer(this->board_.GetSideToMove(), this->board_, nullptr, this->legal_moves_);
+                this->game_bytes_.push_back(static_cast<char>(EncodeMove(move, this->legal_moves_)));
+
+                this->board_.MakeMove(move);
+            }
+
+            this->stream_.write(this->game_bytes_.data(), static_cast<std::streamsize>(this->game_bytes_.size()));
+            if (!this->stream_)
+            {
+                throw std::runtime_error("Cannot write to the archive stream");
+            }
+
+            this->game_offsets_.push_back(this->offset_);
+            this->offset_ += this->game_bytes_.size();
+        }
+
+        void ArchiveWriter::Finish()
+        {
+            if (this->is_finished_)
+            {
+                return;
+            }
+            this->is_finished_ = true;
+
+            std::vector<char> footer;
+            footer.reserve(this->game_offsets_.size() * 8 + FOOTER_SIZE);
+            for (std::uint64_t game_offset : this->game_offsets_)
+            {
+                AppendInteger(footer, game_offset, 8);
+            }
+            AppendInteger(footer, this->game_offsets_.size(), 8);
+            footer.insert(footer.end(), INDEX_MAGIC, INDEX_MAGIC + sizeof(INDEX_MAGIC));
+
+            this->stream_.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+            this->stream_.flush();
+            if (!this->stream_)
+            {
+                throw std::runtime_error("Cannot write to the archive stream");
+            }
+        }
+
+        std::size_t ArchiveWriter::GetGameCount() const
+        {
+            return this->game_offsets_.size();
+        }
+
+        ArchiveReader::ArchiveReader(std::string_view data)
+            : data_(data),
+            game_index_(0),
+            game_count_(0),
+            index_offset_(0)
+        {
+            if (data.size() < HEADER_SIZE + FOOTER_SIZE
+                || std::memcmp(data.data(), ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0)
+            {
+                throw std::runtime_error("Not a game archive");
+            }
+            if (ReadInteger(data, sizeof(ARCHIVE_MAGIC), 2) != ARCHIVE_VERSION)
+            {
+                throw std::runtime_error("Unsupported game archive version");
+            }
+            if (std::memcmp(data.data() + data.size() - sizeof(INDEX_MAGIC), INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+            {
+                throw std::runtime_error("Game archive has no index, it may be truncated");
+            }
+
+            const std::uint64_t game_count = ReadInteger(data, data.size() - FOOTER_SIZE, 8);
+            if (game_count > (data.size() - HEADER_SIZE - FOOTER_SIZE) / 8)
+            {
+                throw std::runtime_error("Game archive index is malformed");
+            }
+
+            this->game_count_ = static_cast<std::size_t>(game_count);
+            this->index_offset_ = data.size() - FOOTER_SIZE - this->game_count_ * 8;
+        }
+
+        bool ArchiveReader::ReadGame(Game &game)
+        {
+            if (this->game_index_ >= this->game_count_)
+            {
+                return false;
+            }
+
+            const std::size_t game_offset = GetGameOffset(this->game_index_);
+            const std::size_t game_end = (this->game_index_ + 1 < this->game_count_)
+                                       ? GetGameOffset(this->game_index_ + 1)
+                                       : this->index_offset_;
+            this->game_index_++;
+
+            if (game_offset + GAME_HEADER_SIZE > game_end)
+            {
+                throw std::runtime_error("Archived game is truncated");
+            }
+
+            const std::size_t ply_count = static_cast<std::size_t>(ReadInteger(this->data_, game_offset, 2));
+            const std::uint8_t result = static_cast<std::uint8_t>(this->data_[game_offset + 2]);
+            const std::size_t fen_length = static_cast<unsigned char>(this->data_[game_offset + 3]);
+            const std::size_t moves_offset = game_offset + GAME_HEADER_SIZE + fen_length;
+
+            if (moves_offset + ply_count != game_end)
+            {
+                throw std::runtime_error("Archived game is truncated");
+            }
+
+            game.Reset();
+            if (fen_length > 0)
+            {
+                try
+                {
+                    game.LoadFen(std::string(this->data_.substr(game_offset + GAME_HEADER_SIZE, fen_length)));
+                }
+                catch (const std::invalid_argument &)
+                {
+                    throw std::runtime_error("Archived game has a malformed FEN");
+                }
+            }
+
+            for (std::size_t ply = 0; ply < ply_count; ply++)
+            {
+                Move move;
+                const std::uint8_t move_index = static_cast<std::uint8_t>(this->data_[moves_offset + ply]);
+
+                if (!DecodeMove(move_index, game.GetLegalMoves(), move) || !game.ExecuteMove(move))
+                {
+                    throw std::runtime_error("Archived game has a move that is not legal");
+                }
+            }
+
+            if (EncodeResult(game.GetGameResult()) != result)
+            {
+                throw std::runtime_error("Archived game does not end in its recorded result");
+            }
+
+            return true;
+        }
+
+        void ArchiveReader::SeekGame(std::size_t game_index)
+        {
+            if (game_index >= this->game_count_)
+            {
+                throw std::out_of_range("No such game in the archive");
+            }
+            this->game_index_ = game_index;
+        }
+
+        std::size_t ArchiveReader::GetGameCount() const
+        {
+            return this->game_count_;
+        }
+
+        std::size_t ArchiveReader::GetGameOffset(std::size_t game_index) const
+        {
+            const std::uint64_t game_offset = ReadInteger(this->data_, this->index_offset_ + game_index * 8, 8);
+            if (game_offset < HEADER_SIZE || game_offset > this->index_offset_)
+            {
+                throw std::runtime_error("Game archive index is malformed");
+            }
+            return static_cast<std::size_t>(game_offset);
+        }
+
+        Replay::ReplaySummary ReplayArchive(std::string_view data,
+                                            const std::function<void(const Game &, const Replay::GameReplay &)> &on_game)
+        {
+            Replay::ReplaySummary summary{0, 0, 0, std::chrono::nanoseconds::zero()};
+
+            ArchiveReader reader(data);
+            Game game;
+            Replay::GameReplay replay{};
+            replay.is_valid = true;
+
+            while (true)
+            {
+                const auto start_time = std::chrono::steady_clock::now();
+                if (!reader.ReadGame(game))
+                {
+                    break;
+                }
+
+                replay.game_number = ++summary.game_count;
+                replay.ply_count = static_cast<int>(game.GetMoveHistory().size());
+                replay.result = game.GetGameResult();
+                game.GenerateFen(replay.final_fen, sizeof(replay.final_fen));
+                replay.elapsed = std::chrono::steady_clock::now() - start_time;
+
+                summary.ply_count += static_cast<std::uint64_t>(replay.ply_count);
+                summary.elapsed += replay.elapsed;
+
+                on_game(game, replay);
+            }
+
+            return summary;
+        }
+    } // namespace Archive
+} // namespace GameLogic
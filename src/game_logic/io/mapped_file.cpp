@@ -0,0 +1,123 @@
+#include "game_logic/io/mapped_file.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GameLogic
+{
+#if defined(_WIN32)
+    MappedFile::MappedFile(const std::string &path)
+        : data_(nullptr),
+        size_(0)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Cannot open " + path);
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size))
+        {
+            CloseHandle(file);
+            throw std::runtime_error("Cannot read the size of " + path);
+        }
+        this->size_ = static_cast<std::size_t>(file_size.QuadPart);
+
+        // An empty file cannot be mapped, it simply has no contents
+        if (this->size_ > 0)
+        {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr)
+            {
+                this->data_ = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+
+        if (this->size_ > 0 && this->data_ == nullptr)
+        {
+            throw std::runtime_error("Cannot map " + path);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (this->data_ != nullptr)
+        {
+            UnmapViewOfFile(this->data_);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string &path)
+        : data_(nullptr),
+        size_(0)
+    {
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            throw std::runtime_error("Cannot open " + path);
+        }
+
+        struct stat file_status;
+        if (fstat(file, &file_status) != 0)
+        {
+            close(file);
+            throw std::runtime_error("Cannot read the size of " + path);
+        }
+        this->size_ = static_cast<std::size_t>(file_status.st_size);
+
+        // An empty file cannot be mapped, it simply has no contents
+        if (this->size_ > 0)
+        {
+            void *mapping = mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping == MAP_FAILED)
+            {
+                close(file);
+                throw std::runtime_error("Cannot map " + path);
+            }
+
+            // The file is read front to back once, let the kernel read ahead aggressively
+            madvise(mapping, this->size_, MADV_SEQUENTIAL);
+            this->data_ = static_cast<const char *>(mapping);
+        }
+
+        // The mapping keeps its own reference to the file
+        close(file);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (this->data_ != nullptr)
+        {
+            munmap(const_cast<char *>(this->data_), this->size_);
+        }
+    }
+#endif
+
+    std::string_view MappedFile::GetContents() const
+    {
+        return std::string_view(this->data_, this->size_);
+    }
+
+    std::size_t MappedFile::GetSize() const
+    {
+        return this->size_;
+    }
+} // namespace GameLogic
@@ -0,0 +1,341 @@
+#include "game_logic/io/pgn.hpp"
+#include "game_logic/game.hpp"
+#include "game_logic/replay/replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace GameLogic
+{
+    namespace Pgn
+    {
+        namespace
+        {
+            /** @brief The number of games a worker thread takes at a time. */
+            constexpr std::size_t GAME_BATCH_SIZE = 64;
+
+            bool IsWhitespace(char character)
+            {
+                return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+            }
+
+            // [Name "Value"] up to the opening quote, so a comment line starting with '[' is not taken for a tag
+            bool IsTagLine(std::string_view line)
+            {
+                std::size_t index = 1;
+                while (index < line.size() && (std::isalnum(static_cast<unsigned char>(line[index])) || line[index] == '_'))
+                {
+                    index++;
+                }
+
+                const std::size_t name_end = index;
+                while (index < line.size() && (line[index] == ' ' || line[index] == '\t'))
+                {
+                    index++;
+                }
+
+                return line.front() == '[' && name_end > 1 && index < line.size() && line[index] == '"';
+            }
+
+            void AddToSummary(Replay::ReplaySummary &summary, const Replay::GameReplay &replay)
+            {
+                summary.game_count++;
+                summary.invalid_count += replay.is_valid ? 0 : 1;
+                summary.ply_count += static_cast<std::uint64_t>(replay.ply_count);
+                summary.elapsed += replay.elapsed;
+            }
+
+            void ReplayPgnGame(const PgnGame &pgn_game, Game &game, Replay::GameReplay &replay)
+            {
+                if (SetUpGame(pgn_game, game))
+                {
+                    Replay::ReplayGame(pgn_game.movetext, game, replay);
+                    return;
+                }
+
+                // A malformed FEN tag fails the game before its first move
+                replay.ply_count = 0;
+                replay.is_valid = false;
+                replay.bad_move = pgn_game.GetTag("FEN");
+                replay.declared_result = std::string_view();
+                replay.result = game.GetGameResult();
+                game.GenerateFen(replay.final_fen, sizeof(replay.final_fen));
+                replay.elapsed = std::chrono::nanoseconds::zero();
+            }
+        } // namespace
+
+        std::string_view PgnGame::GetTag(std::string_view name) const
+        {
+            for (const PgnTag &tag : this->tags)
+            {
+                if (tag.name == name)
+                {
+                    return tag.value;
+                }
+            }
+            return std::string_view();
+        }
+
+        PgnReader::PgnReader(std::string_view text, std::size_t offset)
+            : text_(text),
+            index_(offset) {};
+
+        bool PgnReader::ReadGame(PgnGame &game)
+        {
+            SkipWhitespace();
+            if (this->index_ >= this->text_.size())
+            {
+                return false;
+            }
+
+            game.offset = this->index_;
+            game.tags.clear();
+
+            while (this->index_ < this->text_.size() && this->text_[this->index_] == '[')
+            {
+                ReadTag(game);
+                SkipWhitespace();
+            }
+
+            // The movetext ends after the termination marker, or where the next tag section starts if it has none
+            const std::size_t movetext_start = this->index_;
+            std::size_t movetext_end = this->text_.size();
+
+            std::size_t index = this->index_;
+            for (std::string_view token = Replay::NextMoveToken(this->text_, index); !token.empty();
+                 token = Replay::NextMoveToken(this->text_, index))
+            {
+                if (token.front() == '[')
+                {
+                    movetext_end = static_cast<std::size_t>(token.data() - this->text_.data());
+                    break;
+                }
+                if (Replay::IsResultToken(token))
+                {
+                    movetext_end = index;
+                    break;
+                }
+            }
+
+            game.movetext = this->text_.substr(movetext_start, movetext_end - movetext_start);
+            this->index_ = movetext_end;
+
+            return true;
+        }
+
+        std::size_t PgnReader::GetOffset() const
+        {
+            return this->index_;
+        }
+
+        void PgnReader::SkipWhitespace()
+        {
+            while (this->index_ < this->text_.size())
+            {
+                const char character = this->text_[this->index_];
+
+                if (IsWhitespace(character))
+                {
+                    this->index_++;
+                }
+                else if (character == '%' && (this->index_ == 0 || this->text_[this->index_ - 1] == '\n'))
+                {
+                    // An escaped line, ignored by PGN readers
+                    const std::size_t line_end = this->text_.find('\n', this->index_);
+                    this->index_ = (line_end == std::string_view::npos) ? this->text_.size() : line_end + 1;
+                }
+                else
+                {
+                    return;
+                }
+            }
+        }
+
+        // [Name "Value"], the value may hold escaped quotes and brackets
+        void PgnReader::ReadTag(PgnGame &game)
+        {
+            const std::string_view text = this->text_;
+            std::size_t index = this->index_ + 1;
+
+            while (index < text.size() && IsWhitespace(text[index]))
+            {
+                index++;
+            }
+
+            const std::size_t name_start = index;
+            while (index < text.size() && !IsWhitespace(text[index]) && text[index] != '"' && text[index] != ']')
+            {
+                index++;
+            }
+            const std::string_view name = text.substr(name_start, index - name_start);
+
+            std::string_view value;
+            const std::size_t quote = text.find_first_of("\"]\n", index);
+            if (quote != std::string_view::npos && text[quote] == '"')
+            {
+                std::size_t value_end = quote + 1;
+                while (value_end < text.size() && text[value_end] != '"' && text[value_end] != '\n')
+                {
+                    value_end += (text[value_end] == '\\') ? 2 : 1;
+                }
+                value_end = std::min(value_end, text.size());
+
+                value = text.substr(quote + 1, value_end - quote - 1);
+                index = value_end;
+            }
+
+            if (!name.empty())
+            {
+                game.tags.push_back(PgnTag{name, value});
+            }
+
+            const std::size_t line_end = text.find('\n', index);
+            this->index_ = (line_end == std::string_view::npos) ? text.size() : line_end + 1;
+        }
+
+        // Only line starts are looked at, the movetext is left for the worker threads to tokenize
+        std::vector<std::size_t> IndexGames(std::string_view text)
+        {
+            std::vector<std::size_t> offsets;
+            bool is_after_tag = false;
+            std::size_t line_start = 0;
+
+            while (line_start < text.size())
+            {
+                const std::size_t newline = text.find('\n', line_start);
+                const std::size_t line_end = (newline == std::string_view::npos) ? text.size() : newline;
+
+                std::size_t index = line_start;
+                while (index < line_end && IsWhitespace(text[index]))
+                {
+                    index++;
+                }
+
+                if (index < line_end && !(text[index] == '%' && index == line_start))
+                {
+                    const bool is_tag = IsTagLine(text.substr(index, line_end - index));
+
+                    // A game starts at the first tag after movetext, or at the movetext of a first game without tags
+                    if ((is_tag && !is_after_tag) || (!is_tag && offsets.empty()))
+                    {
+                        offsets.push_back(index);
+                    }
+                    is_after_tag = is_tag;
+                }
+
+                line_start = line_end + 1;
+            }
+
+            return offsets;
+        }
+
+        bool SetUpGame(const PgnGame &pgn_game, Game &game)
+        {
+            const std::string_view fen = pgn_game.GetTag("FEN");
+            game.Reset();
+
+            if (fen.empty())
+            {
+                return true;
+            }
+
+            try
+            {
+                game.LoadFen(std::string(fen));
+                return true;
+            }
+            catch (const std::invalid_argument &)
+            {
+                return false;
+            }
+        }
+
+        Replay::ReplaySummary ReplayPgn(std::string_view text, unsigned int thread_count,
+                                        const std::function<void(const PgnGame &, const Game &, const Replay::GameReplay &)> &on_game)
+        {
+            Replay::ReplaySummary summary{0, 0, 0, std::chrono::nanoseconds::zero()};
+
+            if (thread_count <= 1)
+            {
+                PgnReader reader(text);
+                PgnGame pgn_game;
+                Game game;
+                Replay::GameReplay replay{};
+
+                while (reader.ReadGame(pgn_game))
+                {
+                    ReplayPgnGame(pgn_game, game, replay);
+                    replay.game_number = summary.game_count + 1;
+                    AddToSummary(summary, replay);
+                    on_game(pgn_game, game, replay);
+                }
+
+                return summary;
+            }
+
+            // Find where the games start first so every game keeps its number however the threads split the work
+            const std::vector<std::size_t> offsets = IndexGames(text);
+            std::atomic<std::size_t> next_game_index{0};
+            std::mutex mutex;
+
+            auto worker = [&]()
+            {
+                PgnGame pgn_game;
+                Game game;
+                Replay::GameReplay replay{};
+                Replay::ReplaySummary worker_summary{0, 0, 0, std::chrono::nanoseconds::zero()};
+
+                while (true)
+                {
+                    const std::size_t batch_start = next_game_index.fetch_add(GAME_BATCH_SIZE, std::memory_order_relaxed);
+                    if (batch_start >= offsets.size())
+                    {
+                        break;
+                    }
+
+                    const std::size_t batch_end = std::min(batch_start + GAME_BATCH_SIZE, offsets.size());
+                    for (std::size_t game_index = batch_start; game_index < batch_end; game_index++)
+                    {
+                        PgnReader reader(text, offsets[game_index]);
+                        reader.ReadGame(pgn_game);
+                        ReplayPgnGame(pgn_game, game, replay);
+                        replay.game_number = game_index + 1;
+                        AddToSummary(worker_summary, replay);
+
+                        std::lock_guard<std::mutex> lock(mutex);
+                        on_game(pgn_game, game, replay);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                summary.game_count += worker_summary.game_count;
+                summary.invalid_count += worker_summary.invalid_count;
+                summary.ply_count += worker_summary.ply_count;
+                summary.elapsed += worker_summary.elapsed;
+            };
+
+            std::vector<std::thread> workers;
+            for (unsigned int thread_index = 0; thread_index < thread_count; thread_index++)
+            {
+                workers.emplace_back(worker);
+            }
+            for (std::thread &thread : workers)
+            {
+                thread.join();
+            }
+
+            return summary;
+        }
+    } // namespace Pgn
+} // namespace GameLogic
@@ -1,7 +1,10 @@
 #include "game_logic/base/direction.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
 
 #include "game_logic/pieces/bishop.hpp"
 
@@ -23,32 +26,21 @@ namespace GameLogic
 	}
 
 	// Get bishop moves from a square
-	// Steps similar to rook but only diagonal directions.
-	// Walk each diagonal until off board or blocked.
+	// Same as rook but the lookup uses the diagonal attack table.
     // Include first enemy then stop; stop on friendly.
 	// !!! Does not check king safety
-	std::vector<Move> Bishop::GetPotentialMoves(
-		const Position& from_position, const  Board& board, const Move* last_move) const
+	void Bishop::GeneratePotentialMoves(
+		const Position& from_position, const Board& board, MoveList& moves, [[maybe_unused]] const Move* last_move) const
 	{
-		static const std::vector<Direction> DiagonalDirs =
-		{
-			Direction::NorthEast,
-			Direction::NorthWest,
-			Direction::SouthEast,
-			Direction::SouthWest
-		};
-
-		// List of positions this Bishop piece can move to
-		std::vector<Position> to_positions = GetPositionsInDirs(from_position, board, DiagonalDirs);
+		const int from_square = Bitboards::ToSquare(from_position);
 
-		// List of moves this Bishop piece can make
-		std::vector<Move> moves;
-		moves.reserve(to_positions.size());
+		// Look up every attacked square, then drop the ones occupied by our own pieces
+		Bitboard to_squares = Attacks::BishopAttacks(from_square, board.GetOccupiedBitboard())
+			& ~board.GetColorBitboard(this->color_);
 
-		for (const Position& to_position : to_positions)
+		while (to_squares)
 		{
-			moves.push_back(Move(Enums::MoveType::Normal, from_position, to_position));
+			moves.PushBack(Move(Enums::MoveType::Normal, from_square, Bitboards::PopLowestSquare(to_squares)));
 		}
-		return moves;
 	}
 }
\ No newline at end of file
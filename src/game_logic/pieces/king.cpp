@@ -1,7 +1,10 @@
 #include "game_logic/base/direction.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
 
 #include "game_logic/pieces/king.hpp"
 
@@ -137,54 +140,49 @@ namespace GameLogic
 
 	// Get King moves from a position
     // For each adjacent position: if on board and (empty or enemy) include.
-    // Castling is handled elsewhere.
+    // Castling only needs the king and rook to be unmoved and the squares between them empty.
 	// !!! Does not check king safety
-	std::vector<Move> King::GetPotentialMoves(
-		const Position& from_position, const Board& board, const Move* last_move) const
+	void King::GeneratePotentialMoves(
+		const Position& from_position, const Board& board, MoveList& moves, [[maybe_unused]] const Move* last_move) const
 	{
-		/** Static constant vector defining the 8 adjacent directions a King can move in. */
-        static const std::vector<Direction> AdjacentDirs =
-        {
-            Direction::North,
-            Direction::South,
-            Direction::East,
-            Direction::West,
-            Direction::NorthEast,
-            Direction::NorthWest,
-            Direction::SouthEast,
-            Direction::SouthWest
-        };
-		std::vector<Position> adjacent_to_positions = GetPositionsFromAdjacentDirs(from_position, board, AdjacentDirs);
-		std::vector<Position> castle_to_positions = GetPositionsFromCastling(from_position, board);
-		std::vector<Move> moves;
-
-		for (const Position& to_position : adjacent_to_positions)
+		const int from_square = Bitboards::ToSquare(from_position);
+		const Bitboard occupied = board.GetOccupiedBitboard();
+
+		Bitboard to_squares = Attacks::KingAttacks(from_square) & ~board.GetColorBitboard(this->color_);
+		while (to_squares)
 		{
-			moves.push_back(Move(Enums::MoveType::Normal, from_position, to_position));
+			moves.PushBack(Move(Enums::MoveType::Normal, from_square, Bitboards::PopLowestSquare(to_squares)));
 		}
 
-		for (const Position& to_position : castle_to_positions)
+		if (this->HasMoved())
 		{
-			Position king_side_to_position = from_position + Direction::East * 2;
-			Position queen_side_to_position = from_position + Direction::West * 2;
-
-			Enums::MoveType move_type;
+			return;
+		}
 
-			if (to_position == king_side_to_position)
+		// Check if king side castling is possible
+		const Position ks_rook_position = from_position + Direction::East * Constants::KING_SIDE_ROOK_OFFSET;
+		if (board.IsPositionOnBoard(ks_rook_position))
+		{
+			const Piece *rook = board.GetPieceAt(ks_rook_position);
+			if (rook != nullptr && rook->GetPieceType() == Enums::PieceType::Rook && !rook->HasMoved()
+				&& !(Attacks::Between(from_square, Bitboards::ToSquare(ks_rook_position)) & occupied))
 			{
-				move_type = Enums::MoveType::CastleKS;
+				moves.PushBack(Move(Enums::MoveType::CastleKS, from_position,
+					from_position + Direction::East * Constants::KING_CASTLE_MOVE_OFFSET));
 			}
-			else if (to_position == queen_side_to_position)
+		}
+
+		// Check if queen side castling is possible
+		const Position qs_rook_position = from_position + Direction::West * Constants::QUEEN_SIDE_ROOK_OFFSET;
+		if (board.IsPositionOnBoard(qs_rook_position))
+		{
+			const Piece *rook = board.GetPieceAt(qs_rook_position);
+			if (rook != nullptr && rook->GetPieceType() == Enums::PieceType::Rook && !rook->HasMoved()
+				&& !(Attacks::Between(from_square, Bitboards::ToSquare(qs_rook_position)) & occupied))
 			{
-				move_type = Enums::MoveType::CastleQS;
+				moves.PushBack(Move(Enums::MoveType::CastleQS, from_position,
+					from_position + Direction::West * Constants::KING_CASTLE_MOVE_OFFSET));
 			}
-			else {
-				move_type = Enums::MoveType::Normal;
-			}
-
-			moves.push_back(Move(move_type, from_position, to_position));
 		}
-
-		return moves;
 	}
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "game_logic/base/direction.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
 
 #include "game_logic/pieces/knight.hpp"
 
@@ -60,20 +63,18 @@ namespace GameLogic
 	// Get Knight moves from a position
     // For each jump target: if on board and not friendly piece, include.
 	// !!! Does not check king safety
-	std::vector<Move> Knight::GetPotentialMoves(
-		const Position& from_position, const Board& board, const Move* last_move) const
+	void Knight::GeneratePotentialMoves(
+		const Position& from_position, const Board& board, MoveList& moves, [[maybe_unused]] const Move* last_move) const
 	{
-		// List of positions this Knight piece can move to
-		std::vector<Position> to_positions = GetPositionsFromJumpDirs(from_position, board, Knight::JumpDirs);
+		const int from_square = Bitboards::ToSquare(from_position);
 
-		// List of moves this Knight piece can make
-		std::vector<Move> moves;
-		moves.reserve(to_positions.size());
+		// Jump targets come from the precomputed table, minus the squares holding our own pieces
+		Bitboard to_squares = Attacks::KnightAttacks(from_square)
+			& ~board.GetColorBitboard(this->color_);
 
-		for (const Position& to_position : to_positions)
+		while (to_squares)
 		{
-			moves.push_back(Move(Enums::MoveType::Normal, from_position, to_position));
+			moves.PushBack(Move(Enums::MoveType::Normal, from_square, Bitboards::PopLowestSquare(to_squares)));
 		}
-		return moves;
 	}
 }
\ No newline at end of file
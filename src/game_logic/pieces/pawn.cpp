@@ -1,7 +1,10 @@
 #include "game_logic/base/direction.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
 
 #include "game_logic/pieces/pawn.hpp"
 
@@ -113,61 +116,44 @@ namespace GameLogic
     // 3) Captures: check two diagonal targets; include if enemy there.
     // 4) Promotion / en passant handled later.
     // !!! Does not check king safety
-	std::vector<Move> Pawn::GetPotentialMoves(
-		const Position& from_position, const Board& board, const Move* last_move) const
+	void Pawn::GeneratePotentialMoves(
+		const Position& from_position, const Board& board, MoveList& moves, const Move* last_move) const
 	{
-		std::vector<Position> forward_to_positions = GetForwardPositions(from_position, board);
-		std::vector<Position> capture_to_positions = GetCapturePositions(from_position, board, last_move);
+		const Direction forward_direction = Forward(this->color_);
 
-		std::vector<Move> moves;
-
-		// Check forward positions
-		for (const Position& forward_to_position : forward_to_positions)
+		// One step forward, then two steps if the pawn hasn't moved yet
+		const Position one_move_forward = from_position + forward_direction;
+		if (board.IsPositionOnBoard(one_move_forward) && board.IsPositionEmpty(one_move_forward))
 		{
-			Enums::MoveType move_type;
-
-			int row_difference = std::abs(forward_to_position.GetRow() - from_position.GetRow());
+			moves.PushBack(Move(CanPromotePawn(one_move_forward, board) ? Enums::MoveType::PawnPromotion : Enums::MoveType::Normal,
+				from_position, one_move_forward));
 
-			// If the pawn moves 2 steps foward then it has a move type of Double Pawn
-			// Used for EnPassants
-			if (row_difference == 2)
-			{
-				move_type = Enums::MoveType::DoublePawn; // Double Forward Step
-			}
-			else if (CanPromotePawn(forward_to_position, board))
+			const Position two_move_forward = one_move_forward + forward_direction;
+			if (!HasMoved() && board.IsPositionOnBoard(two_move_forward) && board.IsPositionEmpty(two_move_forward))
 			{
-				move_type = Enums::MoveType::PawnPromotion;
+				moves.PushBack(Move(Enums::MoveType::DoublePawn, from_position, two_move_forward));
 			}
-			else
-			{
-				move_type = Enums::MoveType::Normal; // Single Forward Step
-			}
-
-			moves.push_back(Move(move_type, from_position, forward_to_position));
 		}
 
-		// Check the forward diagonal directions
-		for (const Position& capture_to_position : capture_to_positions)
+		// The diagonal targets come from the precomputed pawn attack table
+		Bitboard capture_squares = Attacks::PawnAttacks(this->color_, Bitboards::ToSquare(from_position))
+			& ~board.GetColorBitboard(this->color_);
+
+		while (capture_squares)
 		{
-			Enums::MoveType move_type;
+			const int to_square = Bitboards::PopLowestSquare(capture_squares);
+			const Position to_position = Bitboards::ToPosition(to_square);
 
 			// Check if pawn can capture by EnPassant otherwise it a normal capture
-			if (CanEnPassant(from_position, capture_to_position, board, last_move))
-			{
-				move_type = Enums::MoveType::EnPassant;
-			}
-			else if (CanPromotePawn(capture_to_position, board))
+			if (CanEnPassant(from_position, to_position, board, last_move))
 			{
-				move_type = Enums::MoveType::PawnPromotion;
+				moves.PushBack(Move(Enums::MoveType::EnPassant, from_position, to_position));
 			}
-			else
+			else if (Bitboards::Contains(board.GetOccupiedBitboard(), to_square))
 			{
-				move_type = Enums::MoveType::Normal;
+				moves.PushBack(Move(CanPromotePawn(to_position, board) ? Enums::MoveType::PawnPromotion : Enums::MoveType::Normal,
+					from_position, to_position));
 			}
-
-			moves.push_back(Move(move_type, from_position, capture_to_position));
 		}
-
-		return moves;
 	}
 }
\ No newline at end of file
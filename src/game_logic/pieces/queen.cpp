@@ -1,7 +1,10 @@
 #include "game_logic/base/direction.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
 
 #include "game_logic/pieces/queen.hpp"
 
@@ -23,36 +26,21 @@ namespace GameLogic
 	}
 
 	// Get queen moves from a position
-    // Combine rook + bishop logic (8 directions).
-    // Walk each direction until off board or blocked; include first enemy then stop.
+    // Combine rook + bishop attack tables (8 directions).
+    // Include first enemy then stop; stop on friendly.
 	// !!! Does not check king safety
-	std::vector<Move> Queen::GetPotentialMoves(
-		const Position& from_position, const Board& board, const Move* last_move) const
+	void Queen::GeneratePotentialMoves(
+		const Position& from_position, const Board& board, MoveList& moves, [[maybe_unused]] const Move* last_move) const
 	{
-		/** Static constant vector defining the eight cardinal directions a bishop can move in. */
-        static const std::vector<Direction> AllDirs =
-        {
-            Direction::North,
-            Direction::South,
-            Direction::East,
-            Direction::West,
-            Direction::NorthEast,
-            Direction::NorthWest,
-            Direction::SouthEast,
-            Direction::SouthWest
-        };
-		// List of positions this Queen piece can move to
-		std::vector<Position> to_positions = this->GetPositionsInDirs(from_position, board, AllDirs);
-
-		// List of moves this Queen piece can make
-		std::vector<Move> moves;
-		moves.reserve(to_positions.size());
-
-		for (const Position& to_position : to_positions)
+		const int from_square = Bitboards::ToSquare(from_position);
+
+		// Look up every attacked square, then drop the ones occupied by our own pieces
+		Bitboard to_squares = Attacks::QueenAttacks(from_square, board.GetOccupiedBitboard())
+			& ~board.GetColorBitboard(this->color_);
+
+		while (to_squares)
 		{
-			moves.push_back(Move(Enums::MoveType::Normal, from_position, to_position));
+			moves.PushBack(Move(Enums::MoveType::Normal, from_square, Bitboards::PopLowestSquare(to_squares)));
 		}
-
-		return moves;
 	}
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "game_logic/base/direction.hpp"
 #include "game_logic/base/position.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/board.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
 
 #include "game_logic/pieces/rook.hpp"
 
@@ -23,34 +26,21 @@ namespace GameLogic
 	}
 
 	// Get rook moves from a position
-    // Steps:
-    // - For each orthogonal dir, go step by step until off the board.
-    // - Stop at the first piece. If enemy, include that position; if friendly, do not include it.
+    // The rook attack table already stops each orthogonal ray at the first piece.
+    // If that piece is an enemy the position is included; if friendly it is masked out.
 	// !!! Does not check king safety
-	std::vector<Move> Rook::GetPotentialMoves(
-		const Position& from_position, const Board& board, const Move* last_move) const
+	void Rook::GeneratePotentialMoves(
+		const Position& from_position, const Board& board, MoveList& moves, [[maybe_unused]] const Move* last_move) const
 	{
-		/** Static constant vector defining the four orthogonal directions a bishop can move in. */
-        static const std::vector<Direction> OrthogonalDirs =
-        {
-            Direction::North,
-            Direction::South,
-            Direction::East,
-            Direction::West
-        };
-
-		// List of positions this Rook piece can move to
-		std::vector<Position> to_positions = this->GetPositionsInDirs(from_position, board, OrthogonalDirs);
-
-		// List of moves this Rook piece can make
-		std::vector<Move> moves;
-		moves.reserve(to_positions.size());
-
-		for (const Position& to_position : to_positions)
+		const int from_square = Bitboards::ToSquare(from_position);
+
+		// Look up every attacked square, then drop the ones occupied by our own pieces
+		Bitboard to_squares = Attacks::RookAttacks(from_square, board.GetOccupiedBitboard())
+			& ~board.GetColorBitboard(this->color_);
+
+		while (to_squares)
 		{
-			moves.push_back(Move(Enums::MoveType::Normal, from_position, to_position));
+			moves.PushBack(Move(Enums::MoveType::Normal, from_square, Bitboards::PopLowestSquare(to_squares)));
 		}
-
-		return moves;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,427 @@
+#include "game_logic/replay/replay.hpp"
+#include "game_logic/game.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/game_result.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
+
+#include "game_logic/enums.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace GameLogic
+{
+    namespace Replay
+    {
+        namespace
+        {
+            bool IsFile(char file)
+            {
+                return file >= 'a' && file <= 'h';
+            }
+
+            bool IsRank(char rank)
+            {
+                return rank >= '1' && rank <= '8';
+            }
+
+            bool IsWhitespace(char character)
+            {
+                return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+            }
+
+            // Row 0 is the 8th rank
+            int AlgebraicToSquare(char file, char rank)
+            {
+                return Bitboards::ToSquare('8' - rank, file - 'a');
+            }
+
+            // UCI writes the promotion piece in lowercase, SAN in uppercase
+            Enums::PieceType PromotionPieceType(char piece)
+            {
+                switch (piece)
+                {
+                    case ('q'): case ('Q'):
+                        return Enums::PieceType::Queen;
+                    case ('r'): case ('R'):
+                        return Enums::PieceType::Rook;
+                    case ('b'): case ('B'):
+                        return Enums::PieceType::Bishop;
+                    case ('n'): case ('N'):
+                        return Enums::PieceType::Knight;
+                    default:
+                        return Enums::PieceType::None;
+                }
+            }
+
+            Enums::PieceType SanPieceType(char piece)
+            {
+                switch (piece)
+                {
+                    case ('N'):
+                        return Enums::PieceType::Knight;
+                    case ('B'):
+                        return Enums::PieceType::Bishop;
+                    case ('R'):
+                        return Enums::PieceType::Rook;
+                    case ('Q'):
+                        return Enums::PieceType::Queen;
+                    case ('K'):
+                        return Enums::PieceType::King;
+                    default:
+                        return Enums::PieceType::None;
+                }
+            }
+
+            // A move token also ends where a comment or variation starts ("e4{best}", "Nf3(Nc3")
+            bool IsTokenEnd(char character)
+            {
+                return IsWhitespace(character) || character == '{' || character == '}' || character == ';'
+                    || character == '(' || character == ')';
+            }
+
+            bool IsUciMove(std::string_view token)
+            {
+                return (token.size() == 4 || (token.size() == 5 && PromotionPieceType(token[4]) != Enums::PieceType::None))
+                    && IsFile(token[0]) && IsRank(token[1]) && IsFile(token[2]) && IsRank(token[3]);
+            }
+
+            // A promotion needs its piece and only a promotion may have one
+            bool SetPromotion(Move &move, Enums::PieceType promotion_piece_type)
+            {
+                if (move.GetMoveType() != Enums::MoveType::PawnPromotion)
+                {
+                    return promotion_piece_type == Enums::PieceType::None;
+                }
+                if (promotion_piece_type == Enums::PieceType::None)
+                {
+                    return false;
+                }
+
+                move.SetPromotionPieceType(promotion_piece_type);
+                return true;
+            }
+
+            bool FindUciMove(std::string_view token, const MoveList &legal_moves, Move &move)
+            {
+                const int from_square = AlgebraicToSquare(token[0], token[1]);
+                const int to_square = AlgebraicToSquare(token[2], token[3]);
+                const Enums::PieceType promotion_piece_type = (token.size() == 5) ? PromotionPieceType(token[4]) : Enums::PieceType::None;
+
+                for (const Move &legal_move : legal_moves)
+                {
+                    if (legal_move.GetFromSquare() == from_square && legal_move.GetToSquare() == to_square)
+                    {
+                        move = legal_move;
+                        return SetPromotion(move, promotion_piece_type);
+                    }
+                }
+                return false;
+            }
+
+            bool FindCastleMove(Enums::MoveType castle_type, const MoveList &legal_moves, Move &move)
+            {
+                for (const Move &legal_move : legal_moves)
+                {
+                    if (legal_move.GetMoveType() == castle_type)
+                    {
+                        move = legal_move;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // [piece][from file][from rank][x]<to square>[=promotion], the check and annotation marks are already stripped
+            bool FindSanMove(std::string_view san, const Board &board, const MoveList &legal_moves, Move &move)
+            {
+                if (san == "O-O" || san == "0-0")
+                {
+                    return FindCastleMove(Enums::MoveType::CastleKS, legal_moves, move);
+                }
+                if (san == "O-O-O" || san == "0-0-0")
+                {
+                    return FindCastleMove(Enums::MoveType::CastleQS, legal_moves, move);
+                }
+
+                Enums::PieceType piece_type = SanPieceType(san.front());
+                if (piece_type != Enums::PieceType::None)
+                {
+                    san.remove_prefix(1);
+                }
+                else
+                {
+                    piece_type = Enums::PieceType::Pawn;
+                }
+
+                Enums::PieceType promotion_piece_type = Enums::PieceType::None;
+                if (piece_type == Enums::PieceType::Pawn && !san.empty())
+                {
+                    promotion_piece_type = PromotionPieceType(san.back());
+                    if (promotion_piece_type != Enums::PieceType::None)
+                    {
+                        san.remove_suffix(1);
+                        if (!san.empty() && san.back() == '=')
+                        {
+                            san.remove_suffix(1);
+                        }
+                    }
+                }
+
+                if (san.size() < 2 || !IsFile(san[san.size() - 2]) || !IsRank(san.back()))
+                {
+                    return false;
+                }
+                const int to_square = AlgebraicToSquare(san[san.size() - 2], san.back());
+                san.remove_suffix(2);
+
+                // Whatever is left is the disambiguation and the capture mark
+                int from_col = -1;
+                int from_row = -1;
+                for (char character : san)
+                {
+                    if (IsFile(character))
+                    {
+                        from_col = character - 'a';
+                    }
+                    else if (IsRank(character))
+                    {
+                        from_row = '8' - character;
+                    }
+                    else if (character != 'x')
+                    {
+                        return false;
+                    }
+                }
+
+                const Bitboard pieces = board.GetPieceBitboard(board.GetSideToMove(), piece_type);
+                int match_count = 0;
+
+                for (const Move &legal_move : legal_moves)
+                {
+                    const int from_square = legal_move.GetFromSquare();
+
+                    if (legal_move.GetToSquare() != to_square || !Bitboards::Contains(pieces, from_square)
+                        || (from_col >= 0 && from_square % 8 != from_col)
+                        || (from_row >= 0 && from_square / 8 != from_row))
+                    {
+                        continue;
+                    }
+
+                    move = legal_move;
+                    match_count++;
+                }
+
+                return match_count == 1 && SetPromotion(move, promotion_piece_type);
+            }
+        } // namespace
+
+        bool FindMove(std::string_view token, Game &game, Move &move)
+        {
+            const MoveList &legal_moves = game.GetLegalMoves();
+
+            if (IsUciMove(token))
+            {
+                return FindUciMove(token, legal_moves, move);
+            }
+
+            // Drop the check, mate and annotation marks ("Nf3+", "Qxf7#", "e4!?")
+            while (!token.empty() && (token.back() == '+' || token.back() == '#' || token.back() == '!' || token.back() == '?'))
+            {
+                token.remove_suffix(1);
+            }
+            if (token.empty())
+            {
+                return false;
+            }
+
+            return FindSanMove(token, game.GetBoard(), legal_moves, move);
+        }
+
+        std::string_view NextMoveToken(std::string_view text, std::size_t &index)
+        {
+            while (index < text.size())
+            {
+                const char character = text[index];
+
+                if (IsWhitespace(character) || character == ')' || character == '}')
+                {
+                    index++;
+                }
+                else if (character == '{')
+                {
+                    // A brace comment runs to the closing brace, across lines
+                    const std::size_t comment_end = text.find('}', index);
+                    index = (comment_end == std::string_view::npos) ? text.size() : comment_end + 1;
+                }
+                else if (character == ';')
+                {
+                    // A rest of line comment
+                    const std::size_t comment_end = text.find('\n', index);
+                    index = (comment_end == std::string_view::npos) ? text.size() : comment_end + 1;
+                }
+                else if (character == '(')
+                {
+                    // Skip a variation, variations nest and may hold comments with parentheses in them
+                    int depth = 0;
+                    while (index < text.size())
+                    {
+                        const char variation_character = text[index];
+                        if (variation_character == '{')
+                        {
+                            const std::size_t comment_end = text.find('}', index);
+                            index = (comment_end == std::string_view::npos) ? text.size() : comment_end + 1;
+                            continue;
+                        }
+
+                        index++;
+                        if (variation_character == '(')
+                        {
+                            depth++;
+                        }
+                        else if (variation_character == ')' && --depth == 0)
+                        {
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    const std::size_t token_start = index;
+                    while (index < text.size() && !IsTokenEnd(text[index]))
+                    {
+                        index++;
+                    }
+                    std::string_view token = text.substr(token_start, index - token_start);
+
+                    // Numeric annotation glyphs ("$1") carry no move
+                    if (token.front() == '$')
+                    {
+                        continue;
+                    }
+
+                    // Skip a move number, the move may be written right after it ("12.Nf3", "12...Nf6")
+                    std::size_t digit_count = 0;
+                    while (digit_count < token.size() && token[digit_count] >= '0' && token[digit_count] <= '9')
+                    {
+                        digit_count++;
+                    }
+                    if (digit_count > 0 && digit_count < token.size() && token[digit_count] == '.')
+                    {
+                        token.remove_prefix(digit_count);
+                        while (!token.empty() && token.front() == '.')
+                        {
+                            token.remove_prefix(1);
+                        }
+                        if (token.empty())
+                        {
+                            continue;
+                        }
+                    }
+
+                    return token;
+                }
+            }
+
+            return std::string_view();
+        }
+
+        bool IsResultToken(std::string_view token)
+        {
+            return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+        }
+
+        void ReplayGame(std::string_view moves, Game &game, GameReplay &replay)
+        {
+            const auto start_time = std::chrono::steady_clock::now();
+
+            replay.ply_count = 0;
+            replay.is_valid = true;
+            replay.bad_move = std::string_view();
+            replay.declared_result = std::string_view();
+
+            std::size_t index = 0;
+            for (std::string_view token = NextMoveToken(moves, index); !token.empty(); token = NextMoveToken(moves, index))
+            {
+                if (IsResultToken(token))
+                {
+                    replay.declared_result = token;
+                    break;
+                }
+
+                Move move;
+                if (!FindMove(token, game, move) || !game.ExecuteMove(move))
+                {
+                    replay.is_valid = false;
+                    replay.bad_move = token;
+                    break;
+                }
+                replay.ply_count++;
+            }
+
+            replay.result = game.GetGameResult();
+            game.GenerateFen(replay.final_fen, sizeof(replay.final_fen));
+            replay.elapsed = std::chrono::steady_clock::now() - start_time;
+        }
+
+        ReplaySummary ReplayStream(std::string_view text, const std::function<void(const Game &, const GameReplay &)> &on_game)
+        {
+            ReplaySummary summary{0, 0, 0, std::chrono::nanoseconds::zero()};
+
+            // One Game and one GameReplay are reused for every line
+            Game game;
+            GameReplay replay{};
+
+            while (!text.empty())
+            {
+                const std::size_t line_end = text.find('\n');
+                std::string_view line = text.substr(0, line_end);
+                text.remove_prefix((line_end == std::string_view::npos) ? text.size() : line_end + 1);
+
+                while (!line.empty() && IsWhitespace(line.front()))
+                {
+                    line.remove_prefix(1);
+                }
+                if (line.empty() || line.front() == '#')
+                {
+                    continue;
+                }
+
+                game.Reset();
+                ReplayGame(line, game, replay);
+                replay.game_number = ++summary.game_count;
+
+                summary.invalid_count += replay.is_valid ? 0 : 1;
+                summary.ply_count += static_cast<std::uint64_t>(replay.ply_count);
+                summary.elapsed += replay.elapsed;
+
+                on_game(game, replay);
+            }
+
+            return summary;
+        }
+
+        const char *GameStateToString(Enums::GameState game_state)
+        {
+            switch (game_state)
+            {
+                case (Enums::GameState::Ongoing):
+                    return "Ongoing";
+                case (Enums::GameState::Checkmate):
+                    return "Checkmate";
+                case (Enums::GameState::Stalemate):
+                    return "Stalemate";
+                case (Enums::GameState::ThreeFoldRepetition):
+                    return "ThreeFoldRepetition";
+                case (Enums::GameState::FiftyMoveRule):
+                    return "FiftyMoveRule";
+                default:
+                    return "InsufficientMaterial";
+            }
+        }
+    } // namespace Replay
+} // namespace GameLogic
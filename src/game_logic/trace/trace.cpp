@@ -0,0 +1,176 @@
+#include "game_logic/trace/trace.hpp"
+#include "game_logic/base/move.hpp"
+
+#include "game_logic/constants.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace GameLogic
+{
+    namespace Trace
+    {
+        namespace
+        {
+            std::atomic<TraceSink *> g_sink{nullptr};
+            std::atomic<Level> g_level{Level::Info};
+        } // namespace
+
+        StreamSink::StreamSink(std::ostream &stream)
+            : stream_(stream) {};
+
+        void StreamSink::Write(const TraceEvent &event)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+
+            this->stream_ << '[' << LevelName(event.level) << "] " << event.name;
+            if (event.move.GetMoveType() != Enums::MoveType::None)
+            {
+                this->stream_ << ' ' << event.move.GetFromPosition().PositionToAlgebraic()
+                              << event.move.GetToPosition().PositionToAlgebraic()
+                              << ' ' << Constants::GET_MOVE_TYPE_REPR(event.move.GetMoveType());
+            }
+            this->stream_ << " fifty_move_counter=" << event.fifty_move_counter
+                          << " key=" << std::hex << event.position_key << std::dec << '\n';
+        }
+
+        RingBufferSink::RingBufferSink(std::size_t capacity)
+            : write_index_(0),
+            read_index_(0),
+            dropped_count_(0)
+        {
+            std::size_t slot_count = 1;
+            while (slot_count < capacity)
+            {
+                slot_count *= 2;
+            }
+
+            this->slots_ = std::make_unique<Slot[]>(slot_count);
+            this->mask_ = slot_count - 1;
+
+            for (std::size_t index = 0; index < slot_count; index++)
+            {
+                this->slots_[index].sequence.store(index, std::memory_order_relaxed);
+            }
+        }
+
+        // Claim the slot at the write index with a compare exchange, then publish it through its sequence
+        void RingBufferSink::Write(const TraceEvent &event)
+        {
+            std::size_t position = this->write_index_.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                Slot &slot = this->slots_[position & this->mask_];
+                const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (distance == 0)
+                {
+                    if (this->write_index_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.event = event;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return;
+                    }
+                }
+                else if (distance < 0)
+                {
+                    // The slot still holds an event a full lap behind, the buffer is full
+                    this->dropped_count_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                else
+                {
+                    position = this->write_index_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Claim the slot at the read index, then hand it back to writers one lap ahead
+        bool RingBufferSink::TryRead(TraceEvent &event)
+        {
+            std::size_t position = this->read_index_.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                Slot &slot = this->slots_[position & this->mask_];
+                const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+                if (distance == 0)
+                {
+                    if (this->read_index_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        event = slot.event;
+                        slot.sequence.store(position + this->mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (distance < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = this->read_index_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::uint64_t RingBufferSink::GetDroppedCount() const
+        {
+            return this->dropped_count_.load(std::memory_order_relaxed);
+        }
+
+        void SetSink(TraceSink *sink)
+        {
+            g_sink.store(sink, std::memory_order_release);
+        }
+
+        void SetLevel(Level level)
+        {
+            g_level.store(level, std::memory_order_relaxed);
+        }
+
+        Level GetLevel()
+        {
+            return g_level.load(std::memory_order_relaxed);
+        }
+
+        const char *LevelName(Level level)
+        {
+            switch (level)
+            {
+                case (Level::Debug):
+                    return "debug";
+                case (Level::Info):
+                    return "info";
+                case (Level::Warning):
+                    return "warning";
+                case (Level::Error):
+                    return "error";
+                default:
+                    return "off";
+            }
+        }
+
+        void Write(const TraceEvent &event)
+        {
+            if (event.level < g_level.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            TraceSink *sink = g_sink.load(std::memory_order_acquire);
+            if (sink != nullptr)
+            {
+                sink->Write(event);
+            }
+        }
+    } // namespace Trace
+} // namespace GameLogic
@@ -1,8 +1,11 @@
 #include "game_logic/base/board.hpp"
 #include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
 #include "game_logic/base/move_record.hpp"
 #include "game_logic/base/piece.hpp"
 #include "game_logic/base/position.hpp"
+#include "game_logic/base/bitboard.hpp"
+#include "game_logic/base/attacks.hpp"
 
 #include "game_logic/validator/move_validator.hpp"
 
@@ -11,6 +14,7 @@
 
 #include <vector>
 #include <memory>
+#include <stdexcept>
 
 namespace GameLogic
 {
@@ -19,68 +23,303 @@ namespace GameLogic
     std::vector<Move> MoveValidator::GetLegalMovesAtPosition(
         const Position &position, Enums::Color player_color, Board& board, const Move *last_move)
     {
-        std::vector<Move> legal_moves;
+        MoveList legal_moves;
+        GetLegalMovesAtPosition(position, player_color, board, last_move, legal_moves);
+        return legal_moves.ToVector();
+    }
 
-        // Get the piece at the given position
-        const Piece *piece = board.GetPieceAt(position);
-        if (piece == nullptr || piece->GetColor() != player_color)
+    // Append the legal moves for a piece at a given position
+    void MoveValidator::GetLegalMovesAtPosition(
+        const Position &position, Enums::Color player_color, const Board &board, [[maybe_unused]] const Move *last_move, MoveList &legal_moves)
+    {
+        // No piece can move from a position off the board
+        if (!board.IsPositionOnBoard(position))
         {
-            return {}; // No piece at given position
+            return;
         }
 
-        // Get the potential moves for the piece at the given position
-        std::vector<Move> potential_moves;
+        GenerateLegalMoves(player_color, board, Bitboards::SquareBB(Bitboards::ToSquare(position)), legal_moves);
+    }
+
+    // Get all the legal moves for the current player's turn
+    std::vector<Move> MoveValidator::GetAllLegalMovesForPlayer(Enums::Color player_color, Board &board, const Move *last_move)
+    {
+        MoveList legal_moves;
+        GetAllLegalMovesForPlayer(player_color, board, last_move, legal_moves);
+        return legal_moves.ToVector();
+    }
+
+    // Append all the legal moves for the current player's turn
+    void MoveValidator::GetAllLegalMovesForPlayer(
+        Enums::Color player_color, const Board &board, [[maybe_unused]] const Move *last_move, MoveList &legal_moves)
+    {
+        GenerateLegalMoves(player_color, board, Bitboards::ALL, legal_moves);
+    }
+
+    // Generate legal moves for the player's pieces standing on from_squares
+    // 1. Find the pieces giving check, with two checkers only the king can move
+    // 2. Find the pieces pinned to the king by an enemy slider
+    // 3. Mask every move so that it resolves a single check and keeps pinned pieces on their pin line
+    void MoveValidator::GenerateLegalMoves(
+        Enums::Color player_color, const Board &board, Bitboard from_squares, MoveList &legal_moves)
+    {
+        const Enums::Color opponent_color = (player_color == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+
+        const Bitboard own_pieces = board.GetColorBitboard(player_color);
+        const Bitboard enemy_pieces = board.GetColorBitboard(opponent_color);
+        const Bitboard occupied = own_pieces | enemy_pieces;
 
-        if (piece->GetPieceType() == Enums::PieceType::Pawn)
+        const Bitboard king = board.GetPieceBitboard(player_color, Enums::PieceType::King);
+        const int king_square = Bitboards::ToSquare(FindKingPosition(player_color, board));
+
+        const Bitboard checkers = GetAttackersTo(king_square, opponent_color, board, occupied);
+        const int checker_count = Bitboards::PopCount(checkers);
+
+        // King moves, the king is taken off the board so it can not hide behind itself on a checking ray
+        if (from_squares & king)
         {
-            // last move is used by pawns to detect double pawn moves and enpassant
-            potential_moves = piece->GetPotentialMoves(position, board, last_move);
+            const Bitboard attacked_squares = GetAttackedSquares(opponent_color, board, occupied ^ king);
+
+            Bitboard to_squares = Attacks::KingAttacks(king_square) & ~own_pieces & ~attacked_squares;
+            while (to_squares)
+            {
+                legal_moves.PushBack(Move(Enums::MoveType::Normal, king_square, Bitboards::PopLowestSquare(to_squares)));
+            }
+
+            // Removing the king only lengthens rays that already give check, so the same set is valid for castling
+            if (checker_count == 0)
+            {
+                GenerateCastleMoves(player_color, board, king_square, attacked_squares, legal_moves);
+            }
         }
-        else
+
+        // In double check only the king can move
+        if (checker_count > 1)
         {
-            potential_moves = piece->GetPotentialMoves(position, board);
+            return;
         }
 
-        // Check if each potential move is legal
-        for (const Move& move : potential_moves)
+        // With a single checker every other move must capture it or block its ray
+        const Bitboard check_mask = (checker_count == 1)
+                                  ? Attacks::Between(king_square, Bitboards::LowestSquare(checkers)) | checkers
+                                  : Bitboards::ALL;
+
+        // A piece is pinned when it is the only piece between the king and an enemy slider aimed at the king
+        Bitboard pinned = Bitboards::EMPTY;
+        const Bitboard enemy_queens = board.GetPieceBitboard(opponent_color, Enums::PieceType::Queen);
+        Bitboard snipers =
+            (Attacks::RookAttacks(king_square, Bitboards::EMPTY) & (board.GetPieceBitboard(opponent_color, Enums::PieceType::Rook) | enemy_queens))
+          | (Attacks::BishopAttacks(king_square, Bitboards::EMPTY) & (board.GetPieceBitboard(opponent_color, Enums::PieceType::Bishop) | enemy_queens));
+
+        while (snipers)
         {
-            if (IsLegalMove(move, player_color, board))
+            const Bitboard blockers = Attacks::Between(king_square, Bitboards::PopLowestSquare(snipers)) & occupied;
+            if (blockers != Bitboards::EMPTY && (blockers & (blockers - 1)) == Bitboards::EMPTY)
             {
-                legal_moves.push_back(move);
+                pinned |= blockers & own_pieces;
             }
         }
 
-        return legal_moves;
+        const int forward = (player_color == Enums::Color::Light) ? -Constants::BOARD_SIZE : Constants::BOARD_SIZE;
+        const int pawn_start_row = (player_color == Enums::Color::Light) ? Constants::BOARD_SIZE - 2 : 1;
+        const int promotion_row = (player_color == Enums::Color::Light) ? 0 : Constants::BOARD_SIZE - 1;
+
+        Bitboard pieces = own_pieces & ~king & from_squares;
+        while (pieces)
+        {
+            const int from_square = Bitboards::PopLowestSquare(pieces);
+            const Position from_position = Bitboards::ToPosition(from_square);
+
+            // Pinned pieces may only move along the line through the king and the pinning slider
+            Bitboard allowed = check_mask;
+            if (Bitboards::Contains(pinned, from_square))
+            {
+                allowed &= Attacks::Line(king_square, from_square);
+            }
+
+            const Enums::PieceType piece_type = board.GetPieceAt(from_position)->GetPieceType();
+
+            if (piece_type != Enums::PieceType::Pawn)
+            {
+                Bitboard to_squares = Attacks::PieceAttacks(piece_type, from_square, occupied) & ~own_pieces & allowed;
+                while (to_squares)
+                {
+                    legal_moves.PushBack(Move(Enums::MoveType::Normal, from_square, Bitboards::PopLowestSquare(to_squares)));
+                }
+                continue;
+            }
+
+            // Pawn pushes, a double push needs both squares empty and the pawn on its start row
+            const int one_step_square = from_square + forward;
+            if (!Bitboards::Contains(occupied, one_step_square))
+            {
+                if (Bitboards::Contains(allowed, one_step_square))
+                {
+                    const Enums::MoveType move_type = (one_step_square / Constants::BOARD_SIZE == promotion_row)
+                                                    ? Enums::MoveType::PawnPromotion
+                                                    : Enums::MoveType::Normal;
+                    legal_moves.PushBack(Move(move_type, from_square, one_step_square));
+                }
+
+                const int two_step_square = one_step_square + forward;
+                if (from_position.GetRow() == pawn_start_row
+                &&  !Bitboards::Contains(occupied, two_step_square)
+                &&  Bitboards::Contains(allowed, two_step_square))
+                {
+                    legal_moves.PushBack(Move(Enums::MoveType::DoublePawn, from_square, two_step_square));
+                }
+            }
+
+            // Pawn captures
+            Bitboard to_squares = Attacks::PawnAttacks(player_color, from_square) & enemy_pieces & allowed;
+            while (to_squares)
+            {
+                const int to_square = Bitboards::PopLowestSquare(to_squares);
+                const Enums::MoveType move_type = (to_square / Constants::BOARD_SIZE == promotion_row)
+                                                ? Enums::MoveType::PawnPromotion
+                                                : Enums::MoveType::Normal;
+                legal_moves.PushBack(Move(move_type, from_square, to_square));
+            }
+
+            // En passant removes two pawns from one row, which can uncover a check that no pin mask sees,
+            // so the resulting occupancy is tested directly
+            const int en_passant_square = board.GetEnPassantSquare();
+            if (en_passant_square != Bitboards::NO_SQUARE)
+            {
+                const int to_square = en_passant_square;
+                const int captured_square = en_passant_square - forward;
+
+                if (Bitboards::Contains(Attacks::PawnAttacks(player_color, from_square), to_square)
+                &&  Bitboards::Contains(board.GetPieceBitboard(opponent_color, Enums::PieceType::Pawn), captured_square)
+                &&  !Bitboards::Contains(occupied, to_square))
+                {
+                    const Bitboard captured = Bitboards::SquareBB(captured_square);
+                    const Bitboard occupied_after = occupied ^ Bitboards::SquareBB(from_square) ^ captured ^ Bitboards::SquareBB(to_square);
+
+                    if ((GetAttackersTo(king_square, opponent_color, board, occupied_after) & ~captured) == Bitboards::EMPTY)
+                    {
+                        legal_moves.PushBack(Move(Enums::MoveType::EnPassant, from_square, to_square));
+                    }
+                }
+            }
+        }
     }
 
-    // Get all the legal moves for the current player's turn
-    std::vector<Move> MoveValidator::GetAllLegalMovesForPlayer(Enums::Color player_color, Board &board, const Move *last_move)
+    // 1. The castling right is still held (Board clears it when the king or rook moves or is captured)
+    // 2. Squares between king and rook are empty
+    // 3. King is not in check (checked by the caller)
+    // 4. King does not pass through or land on a square under attack
+    void MoveValidator::GenerateCastleMoves(
+        Enums::Color player_color, const Board &board, int king_square, Bitboard attacked_squares, MoveList &legal_moves)
     {
-        std::vector<Move> legal_moves;
+        const Position king_position = Bitboards::ToPosition(king_square);
+        const int home_row = (player_color == Enums::Color::Light) ? Constants::BOARD_SIZE - 1 : 0;
+        const int king_start_col = 4;
 
-        // Iterate over all rows and columns of the board
-        for (int row = 0; row < Constants::BOARD_SIZE; row++)
+        const int castling_rights = board.GetCastlingRights();
+        if (king_position.GetRow() != home_row || king_position.GetCol() != king_start_col || castling_rights == Constants::CASTLE_NONE)
         {
-            for (int col = 0; col < Constants::BOARD_SIZE; col++)
+            return;
+        }
+
+        const Bitboard occupied = board.GetOccupiedBitboard();
+
+        for (Enums::MoveType move_type : {Enums::MoveType::CastleKS, Enums::MoveType::CastleQS})
+        {
+            const bool is_king_side = move_type == Enums::MoveType::CastleKS;
+            const Direction towards_rook = is_king_side ? Direction::East : Direction::West;
+            const int rook_offset = is_king_side ? Constants::KING_SIDE_ROOK_OFFSET : Constants::QUEEN_SIDE_ROOK_OFFSET;
+            const int castling_right = (player_color == Enums::Color::Light)
+                                     ? (is_king_side ? Constants::CASTLE_LIGHT_KS : Constants::CASTLE_LIGHT_QS)
+                                     : (is_king_side ? Constants::CASTLE_DARK_KS : Constants::CASTLE_DARK_QS);
+
+            if (!(castling_rights & castling_right))
             {
-                Position from_position = Position(row, col);
-                const Piece *piece = board.GetPieceAt(from_position);
+                continue;
+            }
 
-                // Skip empty squares and enemy pieces
-                if (piece == nullptr || piece->GetColor() != player_color)
-                {
-                    continue;
-                }
+            const Position rook_position = king_position + towards_rook * rook_offset;
+            const Piece *rook = board.GetPieceAt(rook_position);
+
+            if (rook == nullptr
+            ||  rook->GetPieceType() != Enums::PieceType::Rook
+            ||  rook->GetColor() != player_color)
+            {
+                continue;
+            }
 
-                // Get all legal moves for this piece at a specified position
-                std::vector<Move> legal_moves_at_pos = GetLegalMovesAtPosition(from_position, player_color, board, last_move);
+            const int rook_square = Bitboards::ToSquare(rook_position);
+            if (Attacks::Between(king_square, rook_square) & occupied)
+            {
+                continue;
+            }
 
-                // Append the piece's legal moves to the overall legal moves
-                legal_moves.insert(legal_moves.end(), legal_moves_at_pos.begin(), legal_moves_at_pos.end());
+            // The king crosses one square and lands on the next
+            const Position pass_position = king_position + towards_rook;
+            const Position king_to_position = king_position + towards_rook * Constants::KING_CASTLE_MOVE_OFFSET;
+
+            if (!Bitboards::Contains(attacked_squares, Bitboards::ToSquare(pass_position))
+            &&  !Bitboards::Contains(attacked_squares, Bitboards::ToSquare(king_to_position)))
+            {
+                legal_moves.PushBack(Move(move_type, king_position, king_to_position));
             }
         }
+    }
+
+    // Look outward from the square with each piece's attack pattern and intersect with the attacker's pieces
+    Bitboard MoveValidator::GetAttackersTo(int square, Enums::Color attacker_color, const Board &board, Bitboard occupied)
+    {
+        const Enums::Color defender_color = (attacker_color == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+        const Bitboard queens = board.GetPieceBitboard(attacker_color, Enums::PieceType::Queen);
+
+        return (Attacks::PawnAttacks(defender_color, square) & board.GetPieceBitboard(attacker_color, Enums::PieceType::Pawn))
+             | (Attacks::KnightAttacks(square) & board.GetPieceBitboard(attacker_color, Enums::PieceType::Knight))
+             | (Attacks::KingAttacks(square) & board.GetPieceBitboard(attacker_color, Enums::PieceType::King))
+             | (Attacks::BishopAttacks(square, occupied) & (board.GetPieceBitboard(attacker_color, Enums::PieceType::Bishop) | queens))
+             | (Attacks::RookAttacks(square, occupied) & (board.GetPieceBitboard(attacker_color, Enums::PieceType::Rook) | queens));
+    }
 
-        return legal_moves;
+    // Every attacked square of a color, leaper and pawn patterns are shifted or looked up per piece
+    Bitboard MoveValidator::GetAttackedSquares(Enums::Color attacker_color, const Board &board)
+    {
+        return GetAttackedSquares(attacker_color, board, board.GetOccupiedBitboard());
+    }
+
+    Bitboard MoveValidator::GetAttackedSquares(Enums::Color attacker_color, const Board &board, Bitboard occupied)
+    {
+        // Pawns attack diagonally forward, the file masks stop captures from wrapping around the board
+        const Bitboard pawns = board.GetPieceBitboard(attacker_color, Enums::PieceType::Pawn);
+        Bitboard attacked_squares = (attacker_color == Enums::Color::Light)
+                                  ? ((pawns & ~Bitboards::FILE_A) >> 9) | ((pawns & ~Bitboards::FILE_H) >> 7)
+                                  : ((pawns & ~Bitboards::FILE_A) << 7) | ((pawns & ~Bitboards::FILE_H) << 9);
+
+        Bitboard kings = board.GetPieceBitboard(attacker_color, Enums::PieceType::King);
+        while (kings)
+        {
+            attacked_squares |= Attacks::KingAttacks(Bitboards::PopLowestSquare(kings));
+        }
+
+        Bitboard knights = board.GetPieceBitboard(attacker_color, Enums::PieceType::Knight);
+        while (knights)
+        {
+            attacked_squares |= Attacks::KnightAttacks(Bitboards::PopLowestSquare(knights));
+        }
+
+        const Bitboard queens = board.GetPieceBitboard(attacker_color, Enums::PieceType::Queen);
+
+        Bitboard diagonal_sliders = board.GetPieceBitboard(attacker_color, Enums::PieceType::Bishop) | queens;
+        while (diagonal_sliders)
+        {
+            attacked_squares |= Attacks::BishopAttacks(Bitboards::PopLowestSquare(diagonal_sliders), occupied);
+        }
+
+        Bitboard straight_sliders = board.GetPieceBitboard(attacker_color, Enums::PieceType::Rook) | queens;
+        while (straight_sliders)
+        {
+            attacked_squares |= Attacks::RookAttacks(Bitboards::PopLowestSquare(straight_sliders), occupied);
+        }
+
+        return attacked_squares;
     }
 
     // Helpers used for finding legal moves
@@ -116,50 +355,16 @@ namespace GameLogic
     // Returns true if a specified position can be attacked by a specified player
     bool MoveValidator::IsSquareUnderAttack(Enums::Color attacker_color, const Board &board, const Position &target_position)
     {
-        // Iterate over all the squares or positions in the board
-        for (int row = 0; row < Constants::BOARD_SIZE; row++)
-        {
-            for (int col = 0; col < Constants::BOARD_SIZE; col++)
-            {
-                Position position{row, col};
-                const Piece *piece = board.GetPieceAt(position);
-
-                // Skip if there is no piece or the piece is not the same color as the attacker
-                if (piece == nullptr || piece->GetColor() != attacker_color)
-                {
-                    continue;
-                }
-
-                // Get all potential moves for this piece
-                const std::vector<Move> potential_moves = piece->GetPotentialMoves(position, board);
-
-                // Check if any move land on the target position
-                for (const Move &potential_move : potential_moves)
-                {
-                    // Returns true of the piece is able to attack the target position
-                    if (potential_move.GetToPosition() == target_position)
-                    {
-                        return true;
-                    }
-                }
-            }
-        }
-        return false;
+        return GetAttackersTo(Bitboards::ToSquare(target_position), attacker_color, board, board.GetOccupiedBitboard()) != Bitboards::EMPTY;
     }
 
     Position MoveValidator::FindKingPosition(const Enums::Color player_color, const Board &board)
     {
-        for (int row = 0; row < Constants::BOARD_SIZE; row++)
-        {
-            for (int col = 0; col < Constants::BOARD_SIZE; col++)
-            {
-                const Piece *piece = board.GetPieceAt(Position(row, col));
+        const int king_square = board.GetKingSquare(player_color);
 
-                if (piece && piece->GetPieceType() == Enums::PieceType::King && piece->GetColor() == player_color)
-                {
-                    return Position(row, col);
-                }
-            }
+        if (king_square != Bitboards::NO_SQUARE)
+        {
+            return Bitboards::ToPosition(king_square);
         }
 
         throw std::runtime_error("King not found on the board");
@@ -175,13 +380,31 @@ namespace GameLogic
         return IsSquareUnderAttack(opponent_color, board, king_position);
     }
 
+    // Apply the move to the occupancy only and look for attackers of the king's resulting square
     bool MoveValidator::IsKingSafeAfterMove(const Move &move, Enums::Color player_color, Board &board)
     {
-        MoveRecord temp_move = board.MakeMove(move);
-        bool king_in_check = IsKingInCheck(player_color, board);
-        board.UnmakeMove(temp_move);
+        const Enums::Color opponent_color = (player_color == Enums::Color::Light) ? Enums::Color::Dark : Enums::Color::Light;
+        const Position &from_position = move.GetFromPosition();
+        const Position &to_position = move.GetToPosition();
+
+        const Bitboard from = Bitboards::SquareBB(Bitboards::ToSquare(from_position));
+        const Bitboard to = Bitboards::SquareBB(Bitboards::ToSquare(to_position));
+
+        // The enemy piece removed by this move can no longer attack
+        Bitboard captured = board.GetColorBitboard(opponent_color) & to;
+        if (move.GetMoveType() == Enums::MoveType::EnPassant)
+        {
+            captured = Bitboards::SquareBB(Bitboards::ToSquare(Position{from_position.GetRow(), to_position.GetCol()}));
+        }
+
+        const Bitboard occupied = (board.GetOccupiedBitboard() & ~from & ~captured) | to;
+
+        const bool is_king_move = (board.GetPieceBitboard(player_color, Enums::PieceType::King) & from) != Bitboards::EMPTY;
+        const int king_square = is_king_move
+                              ? Bitboards::ToSquare(to_position)
+                              : Bitboards::ToSquare(FindKingPosition(player_color, board));
 
-        return king_in_check == false;
+        return (GetAttackersTo(king_square, opponent_color, board, occupied) & ~captured) == Bitboards::EMPTY;
     }
 
     // 1. King must not have moved (checked via castling rights) (!!! Handled in King class)
@@ -190,44 +413,18 @@ namespace GameLogic
     // 4. King does not pass through or land on a square under attack
     bool MoveValidator::CastleMoveIsLegal(const Move &move, Enums::Color player_color, Board &board)
     {
-        Position king_position = move.GetFromPosition();
-        std::vector<Position> in_between_position;
+        Enums::Color opponent_color = (player_color == Enums::Color::Dark) ? Enums::Color::Light : Enums::Color::Dark;
+        const Bitboard attacked_squares = GetAttackedSquares(opponent_color, board);
 
-        if (IsKingInCheck(player_color, board))
-        {
-            return false;
-        }
+        const Position &king_position = move.GetFromPosition();
+        const Position &king_to_position = move.GetToPosition();
 
-        // Determine the intermediate position between the king and the rook
-        if (move.GetMoveType() == Enums::MoveType::CastleKS)
-        {
-            // King side castling, the positions between the king and the king side rook
-            in_between_position =
-            {
-                king_position + Direction::East * 1,
-                king_position + Direction::East * 2
-            };
-        }
-        else if (move.GetMoveType() == Enums::MoveType::CastleQS)
-        {
-            // Queen side castling, the positions between the king and the queen side rook
-            in_between_position =
-            {
-                king_position + Direction::West * 1,
-                king_position + Direction::West * 2,
-            };
-        }
-
-        Enums::Color opponent_color = (player_color == Enums::Color::Dark) ? Enums::Color::Light : Enums::Color::Dark;
+        // The king's square, the square it passes through and the square it lands on must all be safe
+        const Bitboard king_path = Bitboards::SquareBB(Bitboards::ToSquare(king_position))
+                                 | Attacks::Between(Bitboards::ToSquare(king_position), Bitboards::ToSquare(king_to_position))
+                                 | Bitboards::SquareBB(Bitboards::ToSquare(king_to_position));
 
-        for (const Position& to_position : in_between_position)
-        {
-            if (IsSquareUnderAttack(opponent_color, board, to_position))
-            {
-                return false;
-            }
-        }
-        return true;
+        return (king_path & attacked_squares) == Bitboards::EMPTY;
     }
 
     // Returns true if the move captures a piece
@@ -0,0 +1,238 @@
+#include "game_logic/game.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/fen.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
+#include "game_logic/base/move_record.hpp"
+#include "game_logic/base/san.hpp"
+#include "game_logic/validator/move_validator.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Micro benchmarks of the GameLogic primitives over a fixed position corpus.
+//
+// Every benchmark runs once per corpus position (the benchmark argument is the corpus index and the label
+// is the position name). Write JSON to diff between commits with:
+//   game_logic_bench --benchmark_out=bench.json --benchmark_out_format=json
+
+namespace
+{
+    using namespace GameLogic;
+
+    struct CorpusPosition
+    {
+        const char *name;
+        const char *fen;
+    };
+
+    /** @brief The number of plies Game plays from a corpus position to build up a move history. */
+    constexpr int HISTORY_PLIES = 40;
+
+    // The perft reference positions plus a quiet middle game and a bare endgame
+    const CorpusPosition POSITION_CORPUS[] =
+    {
+        {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"},
+        {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"},
+        {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"},
+        {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"},
+        {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"},
+        {"middlegame", "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2QKB1R w KQ - 0 8"},
+        {"endgame", "8/5k2/8/3K4/8/8/2B5/8 w - - 0 1"},
+    };
+
+    constexpr int CORPUS_SIZE = static_cast<int>(sizeof(POSITION_CORPUS) / sizeof(POSITION_CORPUS[0]));
+
+    const CorpusPosition &GetCorpusPosition(const benchmark::State &state)
+    {
+        return POSITION_CORPUS[state.range(0)];
+    }
+
+    void LoadBoard(Board &board, const CorpusPosition &position)
+    {
+        Fen::LoadFen(position.fen, board);
+    }
+
+    // Play a fixed sequence of legal moves so the repetition check has a history to look through
+    void LoadGame(Game &game, const CorpusPosition &position)
+    {
+        game.LoadFen(position.fen);
+
+        for (int ply = 0; ply < HISTORY_PLIES && !game.IsGameOver(); ply++)
+        {
+            const MoveList &legal_moves = game.GetLegalMoves();
+            const Move move = legal_moves[static_cast<std::size_t>(ply * 7) % legal_moves.Size()];
+            game.ExecuteMove(move);
+        }
+    }
+
+    void BM_MakeUnmakeMove(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Board board;
+        LoadBoard(board, position);
+
+        MoveList moves;
+        MoveValidator::GetAllLegalMovesForPlayer(board.GetSideToMove(), board, nullptr, moves);
+
+        for (auto _ : state)
+        {
+            for (const Move &move : moves)
+            {
+                const MoveRecord record = board.MakeMove(move);
+                benchmark::DoNotOptimize(board.GetZobristKey());
+                board.UnmakeMove(record);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * moves.Size()));
+        state.SetLabel(position.name);
+    }
+
+    void BM_GetAllLegalMovesForPlayer(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Board board;
+        LoadBoard(board, position);
+
+        MoveList moves;
+        for (auto _ : state)
+        {
+            moves.Clear();
+            MoveValidator::GetAllLegalMovesForPlayer(board.GetSideToMove(), board, nullptr, moves);
+            benchmark::DoNotOptimize(moves.Size());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * moves.Size()));
+        state.SetLabel(position.name);
+    }
+
+    void BM_IsKingInCheck(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Board board;
+        LoadBoard(board, position);
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(MoveValidator::IsKingInCheck(board.GetSideToMove(), board));
+        }
+
+        state.SetLabel(position.name);
+    }
+
+    void BM_GenerateFen(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Game game;
+        LoadGame(game, position);
+
+        for (auto _ : state)
+        {
+            std::string fen = game.GenerateFen();
+            benchmark::DoNotOptimize(fen.data());
+        }
+
+        state.SetLabel(position.name);
+    }
+
+    void BM_GenerateFenIntoBuffer(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Game game;
+        LoadGame(game, position);
+
+        char fen[Fen::MAX_FEN_LENGTH];
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(game.GenerateFen(fen, sizeof(fen)));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetLabel(position.name);
+    }
+
+    void BM_WriteSan(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Board board;
+        LoadBoard(board, position);
+
+        MoveList moves;
+        MoveValidator::GetAllLegalMovesForPlayer(board.GetSideToMove(), board, nullptr, moves);
+
+        char san[San::MAX_SAN_LENGTH];
+        for (auto _ : state)
+        {
+            for (const Move &move : moves)
+            {
+                benchmark::DoNotOptimize(San::WriteSanMove(board, move, san));
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * moves.Size()));
+        state.SetLabel(position.name);
+    }
+
+    void BM_ExportPgn(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Game game;
+        LoadGame(game, position);
+
+        std::vector<char> pgn(game.GetPgnBufferSize());
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(game.ExportPgn(pgn.data(), pgn.size()));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetLabel(position.name);
+    }
+
+    void BM_IsThreefoldRepetition(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Game game;
+        LoadGame(game, position);
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(game.IsThreefoldRepetition());
+        }
+
+        state.SetLabel(position.name);
+    }
+
+    void BM_IsInsufficientMaterial(benchmark::State &state)
+    {
+        const CorpusPosition &position = GetCorpusPosition(state);
+        Game game;
+        LoadGame(game, position);
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(game.IsInsufficientMaterial());
+        }
+
+        state.SetLabel(position.name);
+    }
+
+    BENCHMARK(BM_MakeUnmakeMove)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_GetAllLegalMovesForPlayer)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_IsKingInCheck)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_GenerateFen)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_GenerateFenIntoBuffer)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_WriteSan)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_ExportPgn)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_IsThreefoldRepetition)->DenseRange(0, CORPUS_SIZE - 1);
+    BENCHMARK(BM_IsInsufficientMaterial)->DenseRange(0, CORPUS_SIZE - 1);
+} // namespace
+
+BENCHMARK_MAIN();
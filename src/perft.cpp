@@ -0,0 +1,627 @@
+#include "game_logic/game.hpp"
+#include "game_logic/base/board.hpp"
+#include "game_logic/base/fen.hpp"
+#include "game_logic/base/move.hpp"
+#include "game_logic/base/move_list.hpp"
+#include "game_logic/base/move_record.hpp"
+#include "game_logic/base/position_state.hpp"
+#include "game_logic/base/zobrist.hpp"
+#include "game_logic/validator/move_validator.hpp"
+
+#include "game_logic/enums.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Counts the leaf nodes of the legal move tree from a FEN position to verify and time move generation.
+//
+// The tree is split near the root and counted on a pool of worker threads that share a lock-free hash table.
+//
+// Usage:
+//   perft [options] <depth> [fen]            Node count, time and nodes/sec (startpos if no FEN is given)
+//   perft [options] --divide <depth> [fen]   Node count below each root move
+//   perft [options] --suite                  Runs the reference positions and the game rule checks, exits with 1 on any failure
+//
+// Options:
+//   --threads <n>   Worker threads (default: hardware threads)
+//   --hash <mb>     Hash table size in MB, 0 disables it
+
+namespace
+{
+    using namespace GameLogic;
+
+    /** @brief A position with a published node count, see https://www.chessprogramming.org/Perft_Results */
+    struct ReferencePosition
+    {
+        const char *name;
+        const char *fen;
+        int depth;
+        std::uint64_t nodes;
+    };
+
+    const ReferencePosition REFERENCE_POSITIONS[] =
+    {
+        {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603},
+        {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624},
+        {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333},
+        {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487},
+        {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594},
+    };
+
+    /** @brief The default perft hash table size in MB. */
+    constexpr std::size_t DEFAULT_HASH_MB = 64;
+
+    const Enums::PieceType PROMOTION_PIECE_TYPES[] =
+    {
+        Enums::PieceType::Queen, Enums::PieceType::Rook, Enums::PieceType::Bishop, Enums::PieceType::Knight
+    };
+
+    std::string MoveToUCI(const Move &move)
+    {
+        std::string uci = move.GetFromPosition().PositionToAlgebraic() + move.GetToPosition().PositionToAlgebraic();
+
+        switch (move.GetPromotionPieceType())
+        {
+            case (Enums::PieceType::Queen):
+                return uci + 'q';
+            case (Enums::PieceType::Rook):
+                return uci + 'r';
+            case (Enums::PieceType::Bishop):
+                return uci + 'b';
+            case (Enums::PieceType::Knight):
+                return uci + 'n';
+            default:
+                return uci;
+        }
+    }
+
+    // Plays a move given in UCI notation, false if it is not legal
+    bool PlayMove(Game &game, const std::string &uci)
+    {
+        for (const Move &move : game.GetLegalMoves())
+        {
+            if (move.ToUCI() == uci)
+            {
+                return game.ExecuteMove(move);
+            }
+        }
+        return false;
+    }
+
+    // Knights out and back twice: the start position occurs a third time after the last move
+    const char *const REPETITION_MOVES[] = {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1", "f6g8"};
+
+    bool CheckThreefoldRepetition(bool undo_and_redo)
+    {
+        Game game;
+        for (const char *uci : REPETITION_MOVES)
+        {
+            if (!PlayMove(game, uci))
+            {
+                return false;
+            }
+
+            // Redoing a move must restore the fifty move counter the repetition scan relies on
+            if (undo_and_redo)
+            {
+                game.UnExecuteMove();
+                game.ReExecuteMove();
+            }
+        }
+
+        return game.GetGameResult().GetGameState() == Enums::GameState::ThreeFoldRepetition
+            && game.GenerateFen() == "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 8 5";
+    }
+
+    // Positions the move generator can't play from: pawns on the last ranks, the side not to move in check,
+    // and more pieces than fit the material signature
+    const char *const UNPLAYABLE_FENS[] =
+    {
+        "P3k3/8/8/8/8/8/8/4K2p w - - 0 1",
+        "4k3/8/8/8/8/8/4R3/4K3 w - - 0 1",
+        "qqqqqqqq/qqqqqqqq/4k3/8/8/8/8/4K3 w - - 0 1",
+    };
+
+    bool CheckUnplayableFenRejected()
+    {
+        for (const char *fen : UNPLAYABLE_FENS)
+        {
+            Game game;
+            try
+            {
+                game.LoadFen(fen);
+                return false;
+            }
+            catch (const std::invalid_argument &)
+            {
+            }
+
+            // A rejected FEN leaves the game as it was
+            if (game.GenerateFen() != "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1")
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool CheckImpossibleCastlingDropped()
+    {
+        Game game;
+        game.LoadFen("4k3/8/8/8/8/8/8/4K3 w KQkq - 0 1");
+        return game.GenerateFen() == "4k3/8/8/8/8/8/8/4K3 w - - 0 1";
+    }
+
+    /** @brief A rule of Game that the suite checks besides move generation. */
+    struct GameCheck
+    {
+        const char *name;
+        bool (*run)();
+    };
+
+    const GameCheck GAME_CHECKS[] =
+    {
+        {"threefold repetition", []() { return CheckThreefoldRepetition(false); }},
+        {"threefold repetition after undo and redo", []() { return CheckThreefoldRepetition(true); }},
+        {"unplayable FEN rejected", CheckUnplayableFenRejected},
+        {"castling without King or Rook dropped", CheckImpossibleCastlingDropped},
+    };
+
+    /** @brief The worker threads and hash table size of a perft run. */
+    struct PerftOptions
+    {
+        unsigned int thread_count;
+        std::size_t hash_mb;
+    };
+
+    /*****************************************************************************************************
+     * @brief A lock-free perft hash table keyed by Zobrist key and remaining depth.
+     *
+     * Every entry holds the node count and a check word (key XOR node count) in two relaxed atomics.
+     * A probe only trusts an entry whose two words agree, so an entry torn by two threads storing at
+     * the same time reads as a miss instead of a wrong count. Entries are always replaced.
+     ****************************************************************************************************/
+    class PerftHashTable
+    {
+        public:
+            /** @brief Allocates the largest power of two number of entries that fits in size_mb. */
+            explicit PerftHashTable(std::size_t size_mb)
+            {
+                const std::size_t max_entries = size_mb * 1024 * 1024 / sizeof(Entry);
+
+                std::size_t entry_count = 1;
+                while (entry_count * 2 <= max_entries)
+                {
+                    entry_count *= 2;
+                }
+
+                this->entries_ = std::make_unique<Entry[]>(entry_count);
+                this->mask_ = entry_count - 1;
+            }
+
+            bool Probe(ZobristKey key, int depth, std::uint64_t &nodes) const
+            {
+                const ZobristKey depth_key = DepthKey(key, depth);
+                const Entry &entry = this->entries_[depth_key & this->mask_];
+
+                const std::uint64_t entry_nodes = entry.nodes.load(std::memory_order_relaxed);
+                const std::uint64_t entry_check = entry.check.load(std::memory_order_relaxed);
+                if ((entry_check ^ entry_nodes) != depth_key)
+                {
+                    return false;
+                }
+
+                nodes = entry_nodes;
+                return true;
+            }
+
+            void Store(ZobristKey key, int depth, std::uint64_t nodes)
+            {
+                const ZobristKey depth_key = DepthKey(key, depth);
+                Entry &entry = this->entries_[depth_key & this->mask_];
+
+                entry.nodes.store(nodes, std::memory_order_relaxed);
+                entry.check.store(depth_key ^ nodes, std::memory_order_relaxed);
+            }
+
+        private:
+            struct Entry
+            {
+                std::atomic<std::uint64_t> check{0};
+                std::atomic<std::uint64_t> nodes{0};
+            };
+
+            // Spread the depths of one position over different entries
+            static ZobristKey DepthKey(ZobristKey key, int depth)
+            {
+                return key ^ (static_cast<std::uint64_t>(depth) * 0x9E3779B97F4A7C15ULL);
+            }
+
+            std::unique_ptr<Entry[]> entries_;
+            std::size_t mask_ = 0;
+    };
+
+    /** @brief A subtree for a worker: the position after the split moves and the depth left below it. */
+    struct PerftTask
+    {
+        PositionState state;
+        std::size_t root_move_index;
+        int depth;
+    };
+
+    /*****************************************************************************************************
+     * @brief One task queue per worker. A worker takes from the back of its own queue and, once that is
+     *        empty, steals from the front of the others, so workers that draw small subtrees keep busy.
+     ****************************************************************************************************/
+    class WorkStealingQueues
+    {
+        public:
+            explicit WorkStealingQueues(std::size_t worker_count)
+                : queues_(worker_count) {}
+
+            void Push(std::size_t worker_index, const PerftTask &task)
+            {
+                Queue &queue = this->queues_[worker_index];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(task);
+            }
+
+            // Every task is pushed before the workers start, so no task left anywhere means the run is done
+            bool Pop(std::size_t worker_index, PerftTask &task)
+            {
+                for (std::size_t offset = 0; offset < this->queues_.size(); offset++)
+                {
+                    Queue &queue = this->queues_[(worker_index + offset) % this->queues_.size()];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (queue.tasks.empty())
+                    {
+                        continue;
+                    }
+
+                    if (offset == 0)
+                    {
+                        task = queue.tasks.back();
+                        queue.tasks.pop_back();
+                    }
+                    else
+                    {
+                        task = queue.tasks.front();
+                        queue.tasks.pop_front();
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            struct Queue
+            {
+                std::mutex mutex;
+                std::deque<PerftTask> tasks;
+            };
+
+            std::vector<Queue> queues_;
+    };
+
+    // The validator returns one PawnPromotion move per square, expand it into one move per promotion piece
+    void GetPerftMoves(const Board &board, MoveList &moves)
+    {
+        MoveList legal_moves;
+        MoveValidator::GetAllLegalMovesForPlayer(board.GetSideToMove(), board, nullptr, legal_moves);
+
+        for (Move move : legal_moves)
+        {
+            if (move.GetMoveType() != Enums::MoveType::PawnPromotion)
+            {
+                moves.PushBack(move);
+                continue;
+            }
+
+            for (Enums::PieceType promotion_piece_type : PROMOTION_PIECE_TYPES)
+            {
+                move.SetPromotionPieceType(promotion_piece_type);
+                moves.PushBack(move);
+            }
+        }
+    }
+
+    std::uint64_t Perft(Board &board, int depth, PerftHashTable *hash_table)
+    {
+        if (depth <= 0)
+        {
+            return 1;
+        }
+
+        std::uint64_t nodes = 0;
+        if (depth > 1 && hash_table != nullptr && hash_table->Probe(board.GetZobristKey(), depth, nodes))
+        {
+            return nodes;
+        }
+
+        MoveList moves;
+        GetPerftMoves(board, moves);
+
+        // Leaf moves only need to be counted, not played
+        if (depth == 1)
+        {
+            return moves.Size();
+        }
+
+        for (const Move &move : moves)
+        {
+            MoveRecord record = board.MakeMove(move);
+            nodes += Perft(board, depth - 1, hash_table);
+            board.UnmakeMove(record);
+        }
+
+        if (hash_table != nullptr)
+        {
+            hash_table->Store(board.GetZobristKey(), depth, nodes);
+        }
+        return nodes;
+    }
+
+    /*****************************************************************************************************
+     * @brief Counts the nodes below each root move on a pool of worker threads.
+     *
+     * The tree is split one or two plies below the root into PositionState snapshots, which are dealt
+     * round robin into the workers' queues. Each worker loads its tasks into its own Board and runs the
+     * single threaded Perft on them, sharing one hash table.
+     ****************************************************************************************************/
+    std::vector<std::uint64_t> ParallelPerft(Board &board, int depth, const PerftOptions &options, PerftHashTable *hash_table)
+    {
+        MoveList root_moves;
+        GetPerftMoves(board, root_moves);
+
+        std::vector<std::uint64_t> root_nodes(root_moves.Size(), 1);
+        if (depth <= 1)
+        {
+            return root_nodes;
+        }
+
+        const std::size_t worker_count = std::max(1u, options.thread_count);
+        WorkStealingQueues queues(worker_count);
+        std::size_t task_count = 0;
+
+        // Two split plies give a few hundred tasks, enough to balance uneven subtrees
+        const PositionState root_state(board);
+        const int split_plies = (depth >= 4) ? 2 : 1;
+
+        for (std::size_t root_index = 0; root_index < root_moves.Size(); root_index++)
+        {
+            const Move &root_move = root_moves[root_index];
+            const PositionState root_move_state = root_state.MakeMove(root_move);
+
+            if (split_plies == 1)
+            {
+                queues.Push(task_count++ % worker_count, PerftTask{root_move_state, root_index, depth - 1});
+                continue;
+            }
+
+            MoveList replies;
+            MoveRecord record = board.MakeMove(root_move);
+            GetPerftMoves(board, replies);
+            board.UnmakeMove(record);
+
+            for (const Move &reply : replies)
+            {
+                queues.Push(task_count++ % worker_count, PerftTask{root_move_state.MakeMove(reply), root_index, depth - 2});
+            }
+        }
+
+        std::vector<std::atomic<std::uint64_t>> subtree_nodes(root_moves.Size());
+        auto work = [&](std::size_t worker_index)
+        {
+            Board worker_board;
+            PerftTask task;
+            while (queues.Pop(worker_index, task))
+            {
+                worker_board.LoadPositionState(task.state);
+                subtree_nodes[task.root_move_index].fetch_add(Perft(worker_board, task.depth, hash_table), std::memory_order_relaxed);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t worker_index = 1; worker_index < worker_count; worker_index++)
+        {
+            workers.emplace_back(work, worker_index);
+        }
+        work(0);
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        for (std::size_t root_index = 0; root_index < root_moves.Size(); root_index++)
+        {
+            root_nodes[root_index] = subtree_nodes[root_index].load(std::memory_order_relaxed);
+        }
+        return root_nodes;
+    }
+
+    struct PerftResult
+    {
+        std::uint64_t nodes;
+        double seconds;
+    };
+
+    PerftResult RunPerft(const std::string &fen, int depth, bool divide, const PerftOptions &options)
+    {
+        Board board;
+        Fen::LoadFen(fen, board);
+
+        std::unique_ptr<PerftHashTable> hash_table;
+        if (options.hash_mb > 0)
+        {
+            hash_table = std::make_unique<PerftHashTable>(options.hash_mb);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<std::uint64_t> root_nodes = ParallelPerft(board, depth, options, hash_table.get());
+        const auto end = std::chrono::steady_clock::now();
+
+        std::uint64_t nodes = (depth <= 0) ? 1 : 0;
+        if (depth > 0)
+        {
+            MoveList root_moves;
+            GetPerftMoves(board, root_moves);
+
+            for (std::size_t root_index = 0; root_index < root_moves.Size(); root_index++)
+            {
+                if (divide)
+                {
+                    std::cout << MoveToUCI(root_moves[root_index]) << ": " << root_nodes[root_index] << '\n';
+                }
+                nodes += root_nodes[root_index];
+            }
+        }
+
+        return PerftResult{nodes, std::chrono::duration<double>(end - start).count()};
+    }
+
+    std::uint64_t NodesPerSecond(const PerftResult &result)
+    {
+        return result.seconds > 0.0 ? static_cast<std::uint64_t>(result.nodes / result.seconds) : 0;
+    }
+
+    int RunSuite(const PerftOptions &options)
+    {
+        int failures = 0;
+        std::uint64_t total_nodes = 0;
+        double total_seconds = 0.0;
+
+        for (const ReferencePosition &position : REFERENCE_POSITIONS)
+        {
+            const PerftResult result = RunPerft(position.fen, position.depth, false, options);
+            const bool passed = result.nodes == position.nodes;
+
+            std::cout << std::left << std::setw(10) << position.name
+                      << " depth " << position.depth
+                      << "  nodes " << std::setw(10) << result.nodes
+                      << " expected " << std::setw(10) << position.nodes
+                      << std::right << std::setw(12) << NodesPerSecond(result) << " nps  "
+                      << (passed ? "ok" : "FAIL") << '\n';
+
+            failures += passed ? 0 : 1;
+            total_nodes += result.nodes;
+            total_seconds += result.seconds;
+        }
+
+        std::cout << '\n';
+        for (const GameCheck &check : GAME_CHECKS)
+        {
+            const bool passed = check.run();
+            std::cout << std::left << std::setw(48) << check.name << std::right << (passed ? "ok" : "FAIL") << '\n';
+            failures += passed ? 0 : 1;
+        }
+
+        std::cout << "\nTotal nodes: " << total_nodes
+                  << "\nTotal time: " << std::fixed << std::setprecision(3) << total_seconds << " s"
+                  << "\nNPS: " << NodesPerSecond(PerftResult{total_nodes, total_seconds})
+                  << "\nFailures: " << failures << '\n';
+
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: perft [options] <depth> [fen]\n"
+                  << "       perft [options] --divide <depth> [fen]\n"
+                  << "       perft [options] --suite\n"
+                  << "Options:\n"
+                  << "       --threads <n>   Worker threads (default: hardware threads)\n"
+                  << "       --hash <mb>     Hash table size in MB, 0 disables it (default: "
+                  << DEFAULT_HASH_MB << ")\n";
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    PerftOptions options{std::max(1u, std::thread::hardware_concurrency()), DEFAULT_HASH_MB};
+    bool suite = false;
+    bool divide = false;
+
+    try
+    {
+        // Options come first, the depth and FEN follow
+        std::size_t arg_index = 0;
+        for (; arg_index < args.size() && args[arg_index].compare(0, 2, "--") == 0; arg_index++)
+        {
+            const std::string &option = args[arg_index];
+            const bool has_value = arg_index + 1 < args.size();
+
+            if (option == "--suite")
+            {
+                suite = true;
+            }
+            else if (option == "--divide")
+            {
+                divide = true;
+            }
+            else if (option == "--threads" && has_value)
+            {
+                options.thread_count = static_cast<unsigned int>(std::stoul(args[++arg_index]));
+            }
+            else if (option == "--hash" && has_value)
+            {
+                options.hash_mb = std::stoul(args[++arg_index]);
+            }
+            else
+            {
+                PrintUsage();
+                return EXIT_FAILURE;
+            }
+        }
+        args.erase(args.begin(), args.begin() + arg_index);
+
+        if (suite)
+        {
+            return RunSuite(options);
+        }
+
+        if (args.empty())
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+
+        const int depth = std::stoi(args[0]);
+
+        // The FEN may be passed quoted or as separate arguments
+        std::string fen;
+        for (std::size_t i = 1; i < args.size(); i++)
+        {
+            fen += (i > 1 ? " " : "") + args[i];
+        }
+
+        const PerftResult result = RunPerft(fen.empty() ? Fen::START_FEN : fen, depth, divide, options);
+
+        std::cout << "\nNodes searched: " << result.nodes
+                  << "\nTime: " << std::fixed << std::setprecision(3) << result.seconds << " s"
+                  << "\nNPS: " << NodesPerSecond(result) << '\n';
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << '\n';
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
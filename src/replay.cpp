@@ -0,0 +1,194 @@
+#include "game_logic/game.hpp"
+#include "game_logic/io/archive.hpp"
+#include "game_logic/io/mapped_file.hpp"
+#include "game_logic/io/pgn.hpp"
+#include "game_logic/replay/replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Replays game archives through Game::ExecuteMove without a window, to validate them and time move execution.
+//
+// The input file holds one game per line: UCI ("e2e4 e7e5") or SAN ("1. e4 e5 2. Nf3") moves from the standard
+// starting position, optionally ending in a result ("1-0", "0-1", "1/2-1/2", "*"). Empty lines and lines starting
+// with '#' are skipped. With --pgn the file is a PGN archive instead, its games are replayed on worker threads and
+// printed in the order they finish. With --archive the file is a binary game archive (see game_logic/io/archive.hpp).
+// The file is memory mapped and parsed in place.
+//
+// Usage:
+//   replay [options] <file>   Prints every game's plies, result, time and final FEN, exits with 1 on any illegal move
+//
+// Options:
+//   --quiet         Only print the games with an illegal move and the summary
+//   --pgn           Read the file as PGN
+//   --archive       Read the file as a binary game archive
+//   --threads <n>   Worker threads for PGN (default: hardware threads)
+//   --write-archive <path>
+//                   Also write every valid game to a binary game archive
+
+namespace
+{
+    using namespace GameLogic;
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: replay [--quiet] [--pgn | --archive] [--threads <n>] [--write-archive <path>] <file>\n";
+    }
+
+    double ToMilliseconds(std::chrono::nanoseconds duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    void PrintGame(const Replay::GameReplay &replay)
+    {
+        std::cout << "game " << replay.game_number << ": ";
+
+        if (!replay.is_valid)
+        {
+            std::cout << "illegal move \"" << replay.bad_move << "\" after " << replay.ply_count << " plies, "
+                      << replay.final_fen << '\n';
+            return;
+        }
+
+        std::cout << replay.ply_count << " plies, "
+                  << replay.result.GetPgnResult() << " (" << Replay::GameStateToString(replay.result.GetGameState()) << ")";
+        if (!replay.declared_result.empty())
+        {
+            std::cout << ", declared " << replay.declared_result;
+        }
+        std::cout << ", " << std::fixed << std::setprecision(3) << ToMilliseconds(replay.elapsed) << " ms, "
+                  << replay.final_fen << '\n';
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    bool quiet = false;
+    bool pgn = false;
+    bool archive = false;
+    std::string archive_path;
+    unsigned int thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    try
+    {
+        // Options come first, the file follows
+        std::size_t arg_index = 0;
+        for (; arg_index < args.size() && args[arg_index].compare(0, 2, "--") == 0; arg_index++)
+        {
+            const std::string &option = args[arg_index];
+
+            if (option == "--quiet")
+            {
+                quiet = true;
+            }
+            else if (option == "--pgn")
+            {
+                pgn = true;
+            }
+            else if (option == "--archive")
+            {
+                archive = true;
+            }
+            else if (option == "--threads" && arg_index + 1 < args.size())
+            {
+                thread_count = static_cast<unsigned int>(std::stoul(args[++arg_index]));
+            }
+            else if (option == "--write-archive" && arg_index + 1 < args.size())
+            {
+                archive_path = args[++arg_index];
+            }
+            else
+            {
+                PrintUsage();
+                return EXIT_FAILURE;
+            }
+        }
+        args.erase(args.begin(), args.begin() + arg_index);
+
+        if (args.size() != 1 || (pgn && archive))
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+
+        std::ios::sync_with_stdio(false);
+
+        const MappedFile file(args[0]);
+        const auto start_time = std::chrono::steady_clock::now();
+
+        std::ofstream archive_stream;
+        std::unique_ptr<Archive::ArchiveWriter> archive_writer;
+        if (!archive_path.empty())
+        {
+            archive_stream.open(archive_path, std::ios::binary | std::ios::trunc);
+            if (!archive_stream)
+            {
+                std::cerr << "Cannot open " << archive_path << '\n';
+                return EXIT_FAILURE;
+            }
+            archive_writer = std::make_unique<Archive::ArchiveWriter>(archive_stream);
+        }
+
+        auto on_game = [quiet, &archive_writer](const Game &game, const Replay::GameReplay &replay)
+        {
+            if (!quiet || !replay.is_valid)
+            {
+                PrintGame(replay);
+            }
+            if (archive_writer && replay.is_valid)
+            {
+                archive_writer->WriteGame(game);
+            }
+        };
+
+        Replay::ReplaySummary summary;
+        if (pgn)
+        {
+            summary = Pgn::ReplayPgn(file.GetContents(), thread_count,
+                                     [&on_game](const Pgn::PgnGame &, const Game &game, const Replay::GameReplay &replay) { on_game(game, replay); });
+        }
+        else if (archive)
+        {
+            summary = Archive::ReplayArchive(file.GetContents(), on_game);
+        }
+        else
+        {
+            summary = Replay::ReplayStream(file.GetContents(), on_game);
+        }
+
+        if (archive_writer)
+        {
+            archive_writer->Finish();
+        }
+
+        // Wall time, the summary's elapsed time adds up the time of every thread
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        std::cout << "\nGames: " << summary.game_count
+                  << "\nInvalid games: " << summary.invalid_count
+                  << "\nPlies: " << summary.ply_count
+                  << "\nTime: " << std::fixed << std::setprecision(3) << seconds << " s"
+                  << "\nGames/sec: " << static_cast<std::uint64_t>(seconds > 0 ? summary.game_count / seconds : 0)
+                  << "\nPlies/sec: " << static_cast<std::uint64_t>(seconds > 0 ? summary.ply_count / seconds : 0) << '\n';
+
+        return (summary.invalid_count == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}